@@ -3,6 +3,18 @@
 #include "chess_moves.h"
 #include "sensor_test.h"
 #include "chess_bot.h"
+#include "chess_puzzle.h"
+#include "chess_search.h"
+#include "chess_nnue.h"
+#include "chess_tt.h"
+#include "uci_engine.h"
+
+// Uncomment to evaluate with an NNUE network in the on-board engine. The
+// header must define NNUE_NETWORK (4-byte aligned) and NNUE_NETWORK_SIZE.
+// #define USE_NNUE_NETWORK
+#ifdef USE_NNUE_NETWORK
+  #include "nnue_network.h"
+#endif
 
 // Uncomment the next line to enable WiFi features (requires compatible board)
 #define ENABLE_WIFI  // Currently disabled - RP2040 boards use local mode only
@@ -29,25 +41,49 @@ enum GameMode {
   MODE_CHESS_MOVES = 1,
   MODE_CHESS_BOT = 2,      // Chess vs Bot mode (Medium difficulty)
   MODE_GAME_3 = 3,         // Black AI Stockfish (Medium difficulty)
-  MODE_SENSOR_TEST = 4
+  MODE_SENSOR_TEST = 4,
+  MODE_UCI = 5,            // UCI engine over Serial, entered by sending "uci"
+  MODE_PUZZLE = 6          // Mate puzzles from the compiled-in database
 };
 
+// Transposition table for the on-board engine, sized to each board's RAM
+#if defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+  #define TT_ENTRIES 4096
+#else
+  #define TT_ENTRIES 256
+#endif
+
 // Global instances
 BoardDriver boardDriver;
 ChessEngine chessEngine;
-ChessMoves chessMoves(&boardDriver, &chessEngine);
+NNUEEvaluator nnueEvaluator;
+ChessSearch chessSearch(&chessEngine, &nnueEvaluator);
+TTEntry ttStorage[TT_ENTRIES];
+TranspositionTable transpositionTable;
+ChessMoves chessMoves(&boardDriver, &chessEngine, &chessSearch);
 SensorTest sensorTest(&boardDriver);
-ChessBot chessBot(&boardDriver, &chessEngine, BOT_MEDIUM, true);   // Mode 2: Player White, AI Black, Medium
-ChessBot chessBot3(&boardDriver, &chessEngine, BOT_MEDIUM, false);   // Mode 3: Player Black, AI White, Hard
+ChessBot chessBot(&boardDriver, &chessEngine, &chessSearch, BOT_MEDIUM, true);   // Mode 2: Player White, AI Black, Medium
+ChessBot chessBot3(&boardDriver, &chessEngine, &chessSearch, BOT_MEDIUM, false);   // Mode 3: Player Black, AI White, Hard
+ChessPuzzle chessPuzzle(&boardDriver, &chessEngine);
 
 #ifdef ENABLE_WIFI
 WiFiManager wifiManager;
 #endif
 
+// UCI over Serial: input collects in serialLine until a full line is there
+char serialLine[UCI_MAX_LINE];
+bool pollSerialLine();
+bool readSerialLine(char* buffer, int size);
+void writeSerialLine(const char* line);
+UciEngine uciEngine(&chessEngine, &chessSearch, writeSerialLine, readSerialLine);
+
 // Current game state
 GameMode currentMode = MODE_SELECTION;
 bool modeInitialized = false;
 
+// Blunder warnings for the modes that play a game, switched from the selector
+bool blunderWarnings = false;
+
 // ---------------------------
 // Function Prototypes
 // ---------------------------
@@ -108,6 +144,17 @@ void setup() {
   boardDriver.begin();
   Serial.println("DEBUG: Board driver initialized successfully");
 
+  transpositionTable.init(ttStorage, TT_ENTRIES);
+  chessSearch.setTranspositionTable(&transpositionTable);
+
+#if defined(USE_NNUE_NETWORK) && defined(NNUE_ENABLED)
+  if (nnueEvaluator.load(NNUE_NETWORK, NNUE_NETWORK_SIZE)) {
+    Serial.println("NNUE network loaded for the on-board engine");
+  } else {
+    Serial.println("WARNING: NNUE network rejected, using material evaluation");
+  }
+#endif
+
 #ifdef ENABLE_WIFI
   Serial.println();
   Serial.println("=== WiFi Mode Enabled ===");
@@ -145,6 +192,7 @@ void setup() {
   Serial.println("Position 4 (4,4): Sensor Test");
   Serial.println();
   Serial.println("Place any chess piece on a white LED to select that mode");
+  Serial.println("Or send \"uci\" over Serial to use the board as a UCI engine");
   Serial.println("================================================");
   Serial.println("         Setup Complete - Entering Main Loop");
   Serial.println("================================================");
@@ -162,14 +210,17 @@ void loop() {
     firstLoop = false;
   }
   
-  // Print periodic status every 10 seconds
-  if (millis() - lastDebugPrint > 10000) {
+  // Print periodic status every 10 seconds (not in UCI mode, where it would confuse the GUI)
+  if (currentMode != MODE_UCI && millis() - lastDebugPrint > 10000) {
     Serial.print("DEBUG: Loop running, uptime: ");
     Serial.print(millis() / 1000);
     Serial.println(" seconds");
     lastDebugPrint = millis();
   }
 
+  // Advance the sensor scan by one row; the game modes read its events
+  boardDriver.scanTick();
+
 #ifdef ENABLE_WIFI
   // Handle WiFi clients
   wifiManager.handleClient();
@@ -202,21 +253,29 @@ void loop() {
     bool boardUpdated = false;
     
     float evaluation = 0.0;
+    bool whiteToMove = true;
     if (currentMode == MODE_CHESS_MOVES && modeInitialized) {
       chessMoves.getBoardState(currentBoard);
+      whiteToMove = chessMoves.isWhiteToMove();
       boardUpdated = true;
     } else if (currentMode == MODE_CHESS_BOT && modeInitialized) {
       chessBot.getBoardState(currentBoard);
       evaluation = chessBot.getEvaluation();
+      whiteToMove = chessBot.isWhiteToMove();
       boardUpdated = true;
     } else if (currentMode == MODE_GAME_3 && modeInitialized) {
       chessBot3.getBoardState(currentBoard);
       evaluation = chessBot3.getEvaluation();
+      whiteToMove = chessBot3.isWhiteToMove();
+      boardUpdated = true;
+    } else if (currentMode == MODE_PUZZLE && modeInitialized) {
+      chessPuzzle.getBoardState(currentBoard);
+      whiteToMove = chessPuzzle.isWhiteToMove();
       boardUpdated = true;
     }
     
     if (boardUpdated) {
-      wifiManager.updateBoardState(currentBoard, evaluation);
+      wifiManager.updateBoardState(currentBoard, evaluation, whiteToMove);
     }
     
     lastBoardUpdate = millis();
@@ -241,6 +300,9 @@ void loop() {
       case 4:
         currentMode = MODE_SENSOR_TEST;
         break;
+      case 5:
+        currentMode = MODE_PUZZLE;
+        break;
       default:
         Serial.println("Invalid game mode selected via WiFi");
         selectedMode = 0;
@@ -249,6 +311,7 @@ void loop() {
     
     if (selectedMode > 0) {
       modeInitialized = false;
+      boardDriver.clearOverlay();
       boardDriver.clearAllLEDs();
       wifiManager.resetGameSelection();
       
@@ -271,7 +334,7 @@ void loop() {
     handleGameSelection();
   } else {
     static bool modeChangeLogged = false;
-    if (!modeChangeLogged) {
+    if (!modeChangeLogged && currentMode != MODE_UCI) {
       Serial.print("DEBUG: Mode changed to: ");
       Serial.println(currentMode);
       modeChangeLogged = true;
@@ -296,6 +359,17 @@ void loop() {
       case MODE_SENSOR_TEST:
         sensorTest.update();
         break;
+      case MODE_PUZZLE:
+        chessPuzzle.update();
+        break;
+      case MODE_UCI: {
+        if (pollSerialLine() && !uciEngine.handleCommand(serialLine)) {
+          currentMode = MODE_SELECTION;
+          modeInitialized = false;
+          showGameSelection();
+        }
+        break;
+      }
       default:
         currentMode = MODE_SELECTION;
         modeInitialized = false;
@@ -304,7 +378,12 @@ void loop() {
     }
   }
   
-  delay(50); // Small delay to prevent overwhelming the system
+  // Advance the animations and push any LED frame the rate limit held back
+  boardDriver.showLEDs();
+  
+  // Kept short: the scanner only moves on one row per pass, so a full frame
+  // takes about eight passes
+  delay(1);
 }
 
 // ---------------------------
@@ -315,7 +394,7 @@ void showGameSelection() {
   // Clear all LEDs first
   boardDriver.clearAllLEDs();
   
-  // Light up the 4 selector positions in the middle of the board
+  // Light up the selector positions in the middle of the board
   // Each mode has a different color for easy identification
   // Position 1: Chess Moves (row 3, col 3) - Orange
   boardDriver.setSquareLED(3, 3, 255, 165, 0);
@@ -329,12 +408,36 @@ void showGameSelection() {
   // Position 4: Sensor Test (row 4, col 4) - Red
   boardDriver.setSquareLED(4, 4, 255, 0, 0);
   
+  // Position 5: Puzzles (row 3, col 2) - Purple
+  boardDriver.setSquareLED(3, 2, 128, 0, 255);
+  
+  // Toggle: Blunder warnings (row 3, col 5) - Green when on, dim green when off
+  boardDriver.setSquareLED(3, 5, 0, blunderWarnings ? 255 : 30, 0);
+  
   boardDriver.showLEDs();
 }
 
 void handleGameSelection() {
   boardDriver.readSensors();
   
+  // A GUI (or a person in the serial monitor) starting a UCI session
+  if (pollSerialLine() && strncmp(serialLine, "uci", 3) == 0) {
+    currentMode = MODE_UCI;
+    modeInitialized = false;
+    return;
+  }
+  
+  // Setting a piece down on the toggle square switches blunder warnings;
+  // it has to be lifted off again before the next switch
+  static bool togglePressed = true;
+  bool toggleNow = boardDriver.getSensorState(3, 5);
+  if (toggleNow && !togglePressed) {
+    blunderWarnings = !blunderWarnings;
+    Serial.println(blunderWarnings ? "Blunder warnings on" : "Blunder warnings off");
+    showGameSelection();
+  }
+  togglePressed = toggleNow;
+  
   // Check for piece placement on selector squares
   if (boardDriver.getSensorState(3, 3)) {
     // Chess Moves selected
@@ -368,6 +471,14 @@ void handleGameSelection() {
     boardDriver.clearAllLEDs();
     delay(500);
   }
+  else if (boardDriver.getSensorState(3, 2)) {
+    // Puzzle mode selected
+    Serial.println("Puzzle mode selected!");
+    currentMode = MODE_PUZZLE;
+    modeInitialized = false;
+    boardDriver.clearAllLEDs();
+    delay(500);
+  }
   
   delay(100);
 }
@@ -376,10 +487,12 @@ void initializeSelectedMode(GameMode mode) {
   switch (mode) {
     case MODE_CHESS_MOVES:
       Serial.println("Starting Chess Moves (Human vs Human)...");
+      chessMoves.setBlunderWarnings(blunderWarnings);
       chessMoves.begin();
       break;
     case MODE_CHESS_BOT:
       Serial.println("Starting Chess Bot (Player White vs AI Black - Medium)...");
+      chessBot.setBlunderWarnings(blunderWarnings);
       chessBot.begin();
       break;
     case MODE_SENSOR_TEST:
@@ -388,8 +501,18 @@ void initializeSelectedMode(GameMode mode) {
       break;
     case MODE_GAME_3:
       Serial.println("Starting Black AI Stockfish (Player Black vs AI White - Hard)...");
+      chessBot3.setBlunderWarnings(blunderWarnings);
       chessBot3.begin();
       break;
+    case MODE_PUZZLE:
+      Serial.println("Starting Puzzle Mode (mate puzzles)...");
+      chessPuzzle.begin();
+      break;
+    case MODE_UCI:
+      boardDriver.clearAllLEDs();
+      boardDriver.showLEDs();
+      uciEngine.handleCommand("uci");
+      break;
     default:
       currentMode = MODE_SELECTION;
       modeInitialized = false;
@@ -397,3 +520,37 @@ void initializeSelectedMode(GameMode mode) {
       break;
   }
 }
+
+// ---------------------------
+// UCI SERIAL TRANSPORT
+// ---------------------------
+
+// Non-blocking: collects characters until serialLine holds a full line,
+// which stays there until the next character arrives
+bool pollSerialLine() {
+  static int length = 0;
+  
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c == '\r') continue;
+    if (c == '\n') {
+      serialLine[length] = '\0';
+      length = 0;
+      return true;
+    }
+    if (length < UCI_MAX_LINE - 1) serialLine[length++] = c;
+  }
+  return false;
+}
+
+// The same for UciEngine while it searches, which queues the line itself
+bool readSerialLine(char* buffer, int size) {
+  if (!pollSerialLine()) return false;
+  strncpy(buffer, serialLine, size - 1);
+  buffer[size - 1] = '\0';
+  return true;
+}
+
+void writeSerialLine(const char* line) {
+  Serial.println(line);
+}
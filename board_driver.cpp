@@ -1,6 +1,89 @@
 #include "board_driver.h"
 #include <math.h>
 
+#if defined(ESP32)
+    #include "soc/gpio_reg.h"
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+#elif defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED_RP2040)
+    #include "hardware/structs/sio.h"
+#endif
+
+// ---------------------------
+// Fast GPIO
+// ---------------------------
+#ifdef SHIFT_FAST_IO
+#if !defined(ARDUINO_ARCH_SAMD)
+// Boards with Arduino pin numbering (Nano ESP32) map D-pins to other GPIOs;
+// the RP2040 mbed core names pins by GPIO number
+static int gpioNumber(int pin) {
+#if defined(BOARD_HAS_PIN_REMAP)
+    return digitalPinToGPIONumber(pin);
+#elif defined(ARDUINO_ARCH_MBED)
+    return (int)digitalPinToPinName(pin);
+#else
+    return pin;
+#endif
+}
+#endif
+
+static void resolveFastPin(int pin, FastPin &io) {
+#if defined(ESP32)
+    int gpio = gpioNumber(pin);
+#ifdef GPIO_OUT1_W1TS_REG
+    if (gpio >= 32) {
+        io.set = (volatile uint32_t*)GPIO_OUT1_W1TS_REG;
+        io.clear = (volatile uint32_t*)GPIO_OUT1_W1TC_REG;
+        io.mask = 1UL << (gpio - 32);
+        return;
+    }
+#endif
+    io.set = (volatile uint32_t*)GPIO_OUT_W1TS_REG;
+    io.clear = (volatile uint32_t*)GPIO_OUT_W1TC_REG;
+    io.mask = 1UL << gpio;
+#elif defined(ARDUINO_ARCH_SAMD)
+    PortGroup &port = PORT->Group[g_APinDescription[pin].ulPort];
+    io.set = &port.OUTSET.reg;
+    io.clear = &port.OUTCLR.reg;
+    io.mask = 1UL << g_APinDescription[pin].ulPin;
+#else
+    io.set = &sio_hw->gpio_set;
+    io.clear = &sio_hw->gpio_clr;
+    io.mask = 1UL << gpioNumber(pin);
+#endif
+}
+
+static void resolveFastInput(int pin, const volatile uint32_t* &in, uint32_t &mask) {
+#if defined(ESP32)
+    int gpio = gpioNumber(pin);
+#ifdef GPIO_IN1_REG
+    if (gpio >= 32) {
+        in = (const volatile uint32_t*)GPIO_IN1_REG;
+        mask = 1UL << (gpio - 32);
+        return;
+    }
+#endif
+    in = (const volatile uint32_t*)GPIO_IN_REG;
+    mask = 1UL << gpio;
+#elif defined(ARDUINO_ARCH_SAMD)
+    in = &PORT->Group[g_APinDescription[pin].ulPort].IN.reg;
+    mask = 1UL << g_APinDescription[pin].ulPin;
+#else
+    in = &sio_hw->gpio_in;
+    mask = 1UL << gpioNumber(pin);
+#endif
+}
+
+static inline void fastWrite(const FastPin &io, bool high) {
+    *(high ? io.set : io.clear) = io.mask;
+}
+
+// Keeps clock pulses above the 74HC594's minimum width at 3.3 V
+static inline void edgeDelay() {
+    for (int i = 0; i < SHIFT_EDGE_NOPS; i++) __asm__ __volatile__("nop");
+}
+#endif
+
 // ---------------------------
 // BoardDriver Implementation
 // ---------------------------
@@ -21,6 +104,33 @@ BoardDriver::BoardDriver() : strip(LED_COUNT, LED_PIN, NEO_GRBW + NEO_KHZ800) {
     rowPatterns[5] = 0x20; // row 5
     rowPatterns[6] = 0x40; // row 6
     rowPatterns[7] = 0x80; // row 7
+    
+    overlaySquares = 0;
+    overlayColor = 0;
+    
+    scanRow = -1;
+    scanSelectedAt = 0;
+    scanFrame = 0;
+    scanStable = 0;
+    settleUs = SENSOR_SETTLE_US;
+    shiftEdgeUs = SHIFT_EDGE_US;
+    scanFast = true;
+    scanActiveAt = scanFrameAt = 0;
+    wakeRequest = 0;
+    debounceRequest = 0;
+    scanHold = false;
+    snapshot.occupancy = 0;
+    snapshot.eventTail = 0;
+    snapshotSeq = syncedSeq = 0;
+    eventHead = eventTail = 0;
+#ifdef SENSOR_BACKGROUND_SCAN
+    scanTaskHandle = NULL;
+    scanPause = scanPaused = false;
+#endif
+    
+    debounceCount[0] = debounceCount[1] = debounceCount[2] = 0;
+    liftSamples = SENSOR_LIFT_SAMPLES;
+    placeSamples = SENSOR_PLACE_SAMPLES;
 }
 
 void BoardDriver::begin() {
@@ -28,95 +138,509 @@ void BoardDriver::begin() {
     strip.begin();
     strip.show(); // turn off all pixels
     strip.setBrightness(BRIGHTNESS);
+    for (int i = 0; i < LED_COUNT; i++) ledFrame[i] = ledShown[i] = 0;
+    for (int i = 0; i < ANIMATION_SLOTS; i++) animations[i].type = ANIM_NONE;
+    ledDirty = false;
+    ledShownAt = millis();
 
     // Setup shift register control pins
     pinMode(SER_PIN,   OUTPUT);
     pinMode(SRCLK_PIN, OUTPUT);
     pinMode(RCLK_PIN,  OUTPUT);
+#ifdef SHIFT_FAST_IO
+    resolveFastPin(SER_PIN, serIO);
+    resolveFastPin(SRCLK_PIN, srclkIO);
+    resolveFastPin(RCLK_PIN, rclkIO);
+#endif
 
     // Setup column input pins
     for (int c = 0; c < NUM_COLS; c++) {
         pinMode(colPins[c], INPUT);
     }
+#ifdef SHIFT_FAST_IO
+    // Group the columns by input register so a row costs one read per port
+    columnPortCount = 0;
+    for (int c = 0; c < NUM_COLS; c++) {
+        const volatile uint32_t* in;
+        resolveFastInput(colPins[c], in, columnMask[c]);
+        int port = 0;
+        while (port < columnPortCount && columnPorts[port] != in) port++;
+        if (port == columnPortCount) columnPorts[columnPortCount++] = in;
+        columnPort[c] = port;
+    }
+#endif
 
     // Initialize shift register to no row active
     loadShiftRegister(0x00);
     
-    // Initialize sensor arrays
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            sensorState[row][col] = false;
-            sensorPrev[row][col] = false;
-        }
+    // Pieces already on the board at power-up tune the row timing
+    calibrateSettleTime();
+    
+    // The first scan is taken as is and is the scanner's baseline, so
+    // pieces already on the board do not show up as placements
+    sensorState = readFrame();
+    sensorPrev = sensorState;
+    scanStable = sensorState;
+    snapshot.occupancy = sensorState;
+    loadShiftRegister(0x00);
+    
+#ifdef SENSOR_BACKGROUND_SCAN
+    TaskHandle_t handle;
+    if (xTaskCreate(scanTask, "sensors", SENSOR_TASK_STACK, this, SENSOR_TASK_PRIORITY, &handle) == pdPASS) {
+        scanTaskHandle = handle;
+    } else {
+        Serial.println("Sensor task not started, scanning from loop()");
     }
+#endif
 }
 
 void BoardDriver::loadShiftRegister(byte data) {
+#ifdef SHIFT_FAST_IO
+    fastWrite(rclkIO, false);
+    for (int i = 0; i < 8; i++) {
+        fastWrite(serIO, (data >> i) & 1);
+        edgeDelay();
+        fastWrite(srclkIO, true);
+        edgeDelay();
+        fastWrite(srclkIO, false);
+    }
+    edgeDelay();
+    fastWrite(rclkIO, true);
+    edgeDelay();
+    fastWrite(rclkIO, false);
+#else
     digitalWrite(RCLK_PIN, LOW);
     for (int i = 0; i < 8; i++) {
         bool bitVal = (data & (1 << i)) != 0;
         digitalWrite(SER_PIN, bitVal ? HIGH : LOW);
         digitalWrite(SRCLK_PIN, HIGH);
-        delayMicroseconds(10);
+        delayMicroseconds(shiftEdgeUs);
         digitalWrite(SRCLK_PIN, LOW);
-        delayMicroseconds(10);
+        delayMicroseconds(shiftEdgeUs);
     }
     digitalWrite(RCLK_PIN, HIGH);
-    delayMicroseconds(10);
+    delayMicroseconds(shiftEdgeUs);
     digitalWrite(RCLK_PIN, LOW);
+#endif
 }
 
-void BoardDriver::readSensors() {
+// Column bits of the selected row; a sensor pulls its column LOW when a piece is present
+uint8_t BoardDriver::readColumns() {
+    uint8_t bits = 0;
+#ifdef SHIFT_FAST_IO
+    uint32_t levels[NUM_COLS];
+    for (int port = 0; port < columnPortCount; port++) levels[port] = *columnPorts[port];
+    for (int col = 0; col < NUM_COLS; col++) {
+        if (!(levels[columnPort[col]] & columnMask[col])) bits |= 1 << col;
+    }
+#else
+    for (int col = 0; col < NUM_COLS; col++) {
+        if (digitalRead(colPins[col]) == LOW) bits |= 1 << col;
+    }
+#endif
+    return bits;
+}
+
+uint64_t BoardDriver::readFrame() {
+    uint64_t occupancy = 0;
     for (int row = 0; row < 8; row++) {
         loadShiftRegister(rowPatterns[row]);
-        delayMicroseconds(100);
-        for (int col = 0; col < NUM_COLS; col++) {
-            int sensorVal = digitalRead(colPins[col]);
-            sensorState[row][col] = (sensorVal == LOW);
+        delayMicroseconds(settleUs);
+        occupancy |= (uint64_t)readColumns() << (row * 8);
+    }
+    return occupancy;
+}
+
+bool BoardDriver::frameRepeats(uint64_t reference) {
+    for (int i = 0; i < SENSOR_CALIBRATION_FRAMES; i++) {
+        if (readFrame() != reference) return false;
+    }
+    return true;
+}
+
+bool BoardDriver::calibrateSettleTime() {
+    // Candidates, shortest first; the first that holds up is the minimum
+    static const uint16_t SETTLE_STEPS[] = {2, 5, 10, 15, 20, 30, 40, 60, 80, 100, 150};
+    
+#ifdef SENSOR_BACKGROUND_SCAN
+    // Borrow the matrix from the task between two of its steps
+    if (scanTaskHandle) {
+        __atomic_store_n(&scanPaused, false, __ATOMIC_RELEASE);
+        __atomic_store_n(&scanPause, true, __ATOMIC_RELEASE);
+        while (!__atomic_load_n(&scanPaused, __ATOMIC_ACQUIRE)) delay(1);
+    }
+#endif
+    uint16_t oldSettle = settleUs;
+    uint8_t oldEdge = shiftEdgeUs;
+    
+    // Reference frame at the slowest timings; it must hold steady and show
+    // pieces, since an empty row reads the same however short the wait
+    settleUs = SENSOR_SETTLE_MAX_US;
+    shiftEdgeUs = SHIFT_EDGE_US;
+    uint64_t reference = readFrame();
+    bool calibrated = reference != 0 && frameRepeats(reference);
+    
+    if (calibrated) {
+#ifndef SHIFT_FAST_IO
+        static const uint8_t EDGE_STEPS[] = {0, 1, 2, 5};
+        for (unsigned i = 0; i < sizeof(EDGE_STEPS); i++) {
+            shiftEdgeUs = EDGE_STEPS[i];
+            if (frameRepeats(reference)) break;
+            shiftEdgeUs = SHIFT_EDGE_US;
         }
+#endif
+        int steps = sizeof(SETTLE_STEPS) / sizeof(SETTLE_STEPS[0]);
+        for (int i = 0; i < steps; i++) {
+            settleUs = SETTLE_STEPS[i];
+            if (frameRepeats(reference)) break;
+            settleUs = SENSOR_SETTLE_MAX_US;
+        }
+        
+        // Half again plus a little, for temperature and supply drift
+        settleUs = settleUs + settleUs / 2 + 2;
+        if (settleUs > SENSOR_SETTLE_MAX_US) settleUs = SENSOR_SETTLE_MAX_US;
+        
+        Serial.print("Sensor settle time calibrated: ");
+        Serial.print(settleUs);
+        Serial.print(" us per row, ");
+        Serial.print(shiftEdgeUs);
+        Serial.println(" us per shift edge");
+    } else {
+        settleUs = oldSettle;
+        shiftEdgeUs = oldEdge;
+        Serial.println("Sensor calibration skipped: needs pieces on the board, held still");
     }
     loadShiftRegister(0x00);
+    
+    // Whoever scans next starts a fresh frame
+    scanRow = -1;
+#ifdef SENSOR_BACKGROUND_SCAN
+    __atomic_store_n(&scanPause, false, __ATOMIC_RELEASE);
+#endif
+    return calibrated;
+}
+
+// One sample into the per-square integrators: a square whose raw reading has
+// disagreed with scanStable for its threshold in a row flips, any square
+// that agrees starts over. All 64 squares are counted in parallel, one
+// bitboard per counter bit. Returns the new debounced occupancy.
+uint64_t BoardDriver::debounce(uint64_t raw) {
+    uint64_t differs = raw ^ scanStable;
+    
+    // Ripple-carry increment of the differing squares, reset of the others
+    uint64_t carry = differs;
+    for (int b = 0; b < 3; b++) {
+        uint64_t bit = debounceCount[b];
+        debounceCount[b] = (bit ^ carry) & differs;
+        carry &= bit;
+    }
+    
+    // Occupied squares count towards a lift, empty ones towards a placement
+    uint64_t reached = differs;
+    for (int b = 0; b < 3; b++) {
+        uint64_t threshold = (((liftSamples >> b) & 1) ? scanStable : 0) |
+                             (((placeSamples >> b) & 1) ? ~scanStable : 0);
+        reached &= ~(debounceCount[b] ^ threshold);
+    }
+    
+    for (int b = 0; b < 3; b++) debounceCount[b] &= ~reached;
+    return scanStable ^ reached;
+}
+
+// Takes effect with the scanner's next step (or the next readSensors())
+void BoardDriver::setDebounce(uint8_t lift, uint8_t place) {
+    lift = lift < 1 ? 1 : (lift > SENSOR_DEBOUNCE_MAX ? SENSOR_DEBOUNCE_MAX : lift);
+    place = place < 1 ? 1 : (place > SENSOR_DEBOUNCE_MAX ? SENSOR_DEBOUNCE_MAX : place);
+    __atomic_store_n(&debounceRequest, (uint16_t)(lift | place << 8), __ATOMIC_RELEASE);
+}
+
+void BoardDriver::readSensors() {
+    // Blocking waits poll here, so a frame held back by showLEDs() goes out
+    showLEDs();
+    
+    uint8_t tail;
+#ifdef SENSOR_BACKGROUND_SCAN
+    // The task owns the matrix: wait for a frame read entirely after this
+    // call, at full rate since someone is waiting on it
+    if (scanTaskHandle) {
+        wakeScanner();
+        uint32_t start = __atomic_load_n(&snapshotSeq, __ATOMIC_ACQUIRE) & ~1U;
+        while (__atomic_load_n(&snapshotSeq, __ATOMIC_ACQUIRE) - start < 4) delay(1);
+    } else
+#endif
+    {
+        applyScanRequests();
+        publishFrame(readFrame());
+        loadShiftRegister(0x00);
+        
+        // Re-base the scanner on this frame; its row select is gone too
+        scanRow = -1;
+    }
+    syncFrame(tail);
+    __atomic_store_n(&eventHead, tail, __ATOMIC_RELEASE);
+}
+
+bool BoardDriver::scanTick() {
+    uint8_t tail;
+#ifdef SENSOR_BACKGROUND_SCAN
+    if (!scanTaskHandle) scanStep();
+#else
+    scanStep();
+#endif
+    return syncFrame(tail);
+}
+
+// Takes the latest published frame as the sensor state and gives its event
+// tail; true if it is newer than the last one taken. A read that overlaps a
+// publish is retried, so both always come from the same frame.
+bool BoardDriver::syncFrame(uint8_t &tail) {
+    uint32_t seq;
+    uint64_t occupancy;
+    do {
+        seq = __atomic_load_n(&snapshotSeq, __ATOMIC_ACQUIRE);
+        occupancy = snapshot.occupancy;
+        tail = snapshot.eventTail;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || __atomic_load_n(&snapshotSeq, __ATOMIC_RELAXED) != seq);
+    
+    sensorState = occupancy;
+    bool fresh = (seq != syncedSeq);
+    syncedSeq = seq;
+    return fresh;
+}
+
+// Returns how many milliseconds the scanner can be left alone
+uint32_t BoardDriver::scanStep() {
+    applyScanRequests();
+    if (scanRow < 0) {
+        uint32_t idleFor = millis() - scanFrameAt;
+        if (!scanFast && idleFor < SENSOR_IDLE_FRAME_MS) return SENSOR_IDLE_FRAME_MS - idleFor;
+        scanRow = 0;
+        scanFrame = 0;
+        scanFrameAt = millis();
+        loadShiftRegister(rowPatterns[0]);
+        scanSelectedAt = micros();
+        return 0;
+    }
+    if (micros() - scanSelectedAt < settleUs) return 0;
+    
+    scanFrame |= (uint64_t)readColumns() << (scanRow * 8);
+    if (scanRow < NUM_ROWS - 1) {
+        // Start settling the next row right away
+        scanRow++;
+        loadShiftRegister(rowPatterns[scanRow]);
+        scanSelectedAt = micros();
+        return 0;
+    }
+    
+    // Frame done. Anything still differing from the debounced state is a
+    // piece on the move (or a bounce being filtered), so it keeps the rate up
+    uint32_t now = millis();
+    if (scanFrame != scanStable || __atomic_load_n(&scanHold, __ATOMIC_ACQUIRE)) scanActiveAt = now;
+    publishFrame(scanFrame);
+    if (now - scanActiveAt >= SENSOR_ACTIVE_HOLD_MS) scanFast = false;
+    
+    if (scanFast) {
+        scanRow = 0;
+        scanFrame = 0;
+        scanFrameAt = now;
+        loadShiftRegister(rowPatterns[0]);
+        scanSelectedAt = micros();
+        return 0;
+    }
+    
+    // Idle: deselect the rows until the next frame is due
+    scanRow = -1;
+    loadShiftRegister(0x00);
+    return SENSOR_IDLE_FRAME_MS - (now - scanFrameAt);
+}
+
+// Scanning side: takes over what the game side asked for since the last step
+void BoardDriver::applyScanRequests() {
+    if (__atomic_exchange_n(&wakeRequest, (uint8_t)0, __ATOMIC_ACQUIRE)) {
+        scanActiveAt = millis();
+        scanFast = true;
+    }
+    uint16_t thresholds = __atomic_exchange_n(&debounceRequest, (uint16_t)0, __ATOMIC_ACQUIRE);
+    if (thresholds) {
+        liftSamples = thresholds & 0xFF;
+        placeSamples = thresholds >> 8;
+        debounceCount[0] = debounceCount[1] = debounceCount[2] = 0;
+    }
+}
+
+void BoardDriver::wakeScanner() {
+    __atomic_store_n(&wakeRequest, (uint8_t)1, __ATOMIC_RELEASE);
+}
+
+void BoardDriver::setScanHold(bool hold) {
+    __atomic_store_n(&scanHold, hold, __ATOMIC_RELEASE);
+    if (hold) wakeScanner();
+}
+
+#ifdef SENSOR_BACKGROUND_SCAN
+// One row per tick leaves far more than the settle time between select and
+// read; when idle the task sleeps until the next frame is due
+void BoardDriver::scanTask(void* driver) {
+    BoardDriver* board = (BoardDriver*)driver;
+    for (;;) {
+        if (__atomic_load_n(&board->scanPause, __ATOMIC_ACQUIRE)) {
+            __atomic_store_n(&board->scanPaused, true, __ATOMIC_RELEASE);
+            vTaskDelay(1);
+            continue;
+        }
+        __atomic_store_n(&board->scanPaused, false, __ATOMIC_RELEASE);
+        uint32_t idleMs = board->scanStep();
+        vTaskDelay(idleMs > 1 ? pdMS_TO_TICKS(idleMs) : 1);
+    }
+}
+#endif
+
+// Scanning side: debounces a raw frame, queues an event per square that
+// changed (a full queue drops the newest) and publishes the frame
+void BoardDriver::publishFrame(uint64_t raw) {
+    uint64_t occupancy = debounce(raw);
+    uint32_t now = millis();
+    uint8_t head = __atomic_load_n(&eventHead, __ATOMIC_ACQUIRE);
+    uint8_t tail = eventTail;
+    for (uint64_t changed = occupancy ^ scanStable; changed; changed &= changed - 1) {
+        int square = __builtin_ctzll(changed);
+        uint8_t next = (tail + 1) & (SENSOR_EVENT_QUEUE - 1);
+        if (next == head) break;
+        SensorEvent &event = events[tail];
+        event.square = square;
+        event.type = ((occupancy >> square) & 1) ? SENSOR_PLACE : SENSOR_LIFT;
+        event.timeMs = now;
+        tail = next;
+    }
+    __atomic_store_n(&eventTail, tail, __ATOMIC_RELEASE);
+    scanStable = occupancy;
+    
+    // Sequence lock: odd while the snapshot is half written
+    uint32_t seq = snapshotSeq;
+    __atomic_store_n(&snapshotSeq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    snapshot.occupancy = occupancy;
+    snapshot.eventTail = tail;
+    __atomic_store_n(&snapshotSeq, seq + 2, __ATOMIC_RELEASE);
+}
+
+bool BoardDriver::pollEvent(SensorEvent &event) {
+    uint8_t head = eventHead;
+    if (head == __atomic_load_n(&eventTail, __ATOMIC_ACQUIRE)) return false;
+    event = events[head];
+    __atomic_store_n(&eventHead, (uint8_t)((head + 1) & (SENSOR_EVENT_QUEUE - 1)), __ATOMIC_RELEASE);
+    return true;
+}
+
+void BoardDriver::clearEvents() {
+    __atomic_store_n(&eventHead, __atomic_load_n(&eventTail, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
 }
 
 bool BoardDriver::getSensorState(int row, int col) {
-    return sensorState[row][col];
+    return (sensorState >> (row * 8 + col)) & 1;
 }
 
 bool BoardDriver::getSensorPrev(int row, int col) {
-    return sensorPrev[row][col];
+    return (sensorPrev >> (row * 8 + col)) & 1;
 }
 
 void BoardDriver::updateSensorPrev() {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            sensorPrev[row][col] = sensorState[row][col];
-        }
+    sensorPrev = sensorState;
+}
+
+uint64_t BoardDriver::occupancyOf(const char board[8][8]) {
+    uint64_t occupancy = 0;
+    for (int square = 0; square < 64; square++) {
+        if (board[square >> 3][square & 7] != ' ') occupancy |= 1ULL << square;
     }
+    return occupancy;
 }
 
 int BoardDriver::getPixelIndex(int row, int col) {
     return col * NUM_COLS + (7 - row);
 }
 
+// Leaves the push to the next showLEDs(), which usually follows with new squares lit
 void BoardDriver::clearAllLEDs() {
     for (int i = 0; i < LED_COUNT; i++) {
-        strip.setPixelColor(i, 0);
+        setPixel(i, 0);
     }
-    strip.show();
+    paintOverlay();
 }
 
 void BoardDriver::setSquareLED(int row, int col, uint32_t color) {
     int pixelIndex = getPixelIndex(row, col);
-    strip.setPixelColor(pixelIndex, color);
+    setPixel(pixelIndex, color);
 }
 
 void BoardDriver::setSquareLED(int row, int col, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
     int pixelIndex = getPixelIndex(row, col);
-    strip.setPixelColor(pixelIndex, strip.Color(r, g, b, w));
+    setPixel(pixelIndex, strip.Color(r, g, b, w));
+}
+
+void BoardDriver::setPixel(int index, uint32_t color) {
+    if (ledFrame[index] == color) return;
+    ledFrame[index] = color;
+    ledDirty = true;
 }
 
 void BoardDriver::showLEDs() {
+    if (millis() - ledShownAt < LED_FRAME_MS) return;
+    flushLEDs();
+}
+
+void BoardDriver::flushLEDs() {
+    if (!ledDirty && !isAnimating()) return;
+    
+    // Base layer, then the animations in start order; finished ones drop out
+    uint32_t frame[LED_COUNT];
+    for (int i = 0; i < LED_COUNT; i++) frame[i] = ledFrame[i];
+    uint32_t now = millis();
+    int kept = 0;
+    for (int i = 0; i < ANIMATION_SLOTS && animations[i].type != ANIM_NONE; i++) {
+        if (drawAnimation(animations[i], now - animations[i].startMs, frame)) animations[kept++] = animations[i];
+    }
+    for (int i = kept; i < ANIMATION_SLOTS; i++) animations[i].type = ANIM_NONE;
+    ledDirty = false;
+    
+    bool changed = false;
+    for (int i = 0; i < LED_COUNT; i++) {
+        if (frame[i] == ledShown[i]) continue;
+        ledShown[i] = frame[i];
+        strip.setPixelColor(i, frame[i]);
+        changed = true;
+    }
+    if (!changed) return;
     strip.show();
+    ledShownAt = millis();
+}
+
+void BoardDriver::setOverlay(uint64_t squares, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    uint32_t color = strip.Color(r, g, b, w);
+    if (squares == overlaySquares && color == overlayColor) return;
+    
+    // Turn off squares leaving the overlay, then paint the new set
+    uint64_t removed = overlaySquares & ~squares;
+    for (int square = 0; square < 64; square++) {
+        if ((removed >> square) & 1) setPixel(getPixelIndex(square >> 3, square & 7), 0);
+    }
+    overlaySquares = squares;
+    overlayColor = color;
+    paintOverlay();
+    showLEDs();
+}
+
+void BoardDriver::clearOverlay() {
+    setOverlay(0, 0, 0, 0, 0);
+}
+
+void BoardDriver::paintOverlay() {
+    for (int square = 0; square < 64; square++) {
+        if ((overlaySquares >> square) & 1) {
+            setPixel(getPixelIndex(square >> 3, square & 7), overlayColor);
+        }
+    }
 }
 
 void BoardDriver::highlightSquare(int row, int col, uint32_t color) {
@@ -125,179 +649,145 @@ void BoardDriver::highlightSquare(int row, int col, uint32_t color) {
 }
 
 void BoardDriver::blinkSquare(int row, int col, int times) {
-    int pixelIndex = getPixelIndex(row, col);
-    for (int i = 0; i < times; i++) {
-        strip.setPixelColor(pixelIndex, strip.Color(0, 0, 0, 255));
-        strip.show();
-        delay(200);
-        strip.setPixelColor(pixelIndex, 0);
-        strip.show();
-        delay(200);
-    }
+    flashSquares(1ULL << (row * 8 + col), color(0, 0, 0, 255), times, 400, true);
+}
+
+// Red flash, e.g. on a piece a move has left hanging; the overlay is kept
+void BoardDriver::warnSquare(int row, int col, int times) {
+    flashSquares(1ULL << (row * 8 + col), color(255, 0, 0, 0), times, 300);
+}
+
+void BoardDriver::flashSquares(uint64_t squares, uint32_t flashColor, int times, int periodMs, bool offDark) {
+    if (times <= 0 || periodMs <= 0) return;
+    Animation animation = {};
+    animation.type = ANIM_FLASH;
+    animation.squares = squares;
+    animation.color = flashColor;
+    animation.times = times;
+    animation.periodMs = periodMs;
+    animation.offDark = offDark;
+    startAnimation(animation);
 }
 
 void BoardDriver::fireworkAnimation() {
-    float centerX = 3.5;
-    float centerY = 3.5;
-    
-    // Expansion phase:
-    for (float radius = 0; radius < 6; radius += 0.5) {
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                float dx = col - centerX;
-                float dy = row - centerY;
-                float dist = sqrt(dx * dx + dy * dy);
-                int pixelIndex = getPixelIndex(row, col);
-                if (fabs(dist - radius) < 0.5)
-                    strip.setPixelColor(pixelIndex, strip.Color(0, 0, 0, 255));
-                else
-                    strip.setPixelColor(pixelIndex, 0);
-            }
-        }
-        strip.show();
-        delay(100);
+    Animation animation = {};
+    animation.type = ANIM_FIREWORK;
+    startAnimation(animation);
+}
+
+void BoardDriver::captureAnimation() {
+    Animation animation = {};
+    animation.type = ANIM_CAPTURE;
+    startAnimation(animation);
+}
+
+void BoardDriver::promotionAnimation(int col) {
+    Animation animation = {};
+    animation.type = ANIM_PROMOTION;
+    animation.squares = 0x0101010101010101ULL << col;
+    startAnimation(animation);
+}
+
+// The playing animations fill the slots from the front, oldest first
+bool BoardDriver::isAnimating() {
+    return animations[0].type != ANIM_NONE;
+}
+
+// Appends an animation, dropping the oldest one if all slots are playing
+void BoardDriver::startAnimation(const Animation &animation) {
+    int count = 0;
+    while (count < ANIMATION_SLOTS && animations[count].type != ANIM_NONE) count++;
+    if (count == ANIMATION_SLOTS) {
+        for (int i = 1; i < ANIMATION_SLOTS; i++) animations[i - 1] = animations[i];
+        count--;
     }
-    
-    // Contraction phase:
-    for (float radius = 6; radius > 0; radius -= 0.5) {
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                float dx = col - centerX;
-                float dy = row - centerY;
-                float dist = sqrt(dx * dx + dy * dy);
-                int pixelIndex = getPixelIndex(row, col);
-                if (fabs(dist - radius) < 0.5)
-                    strip.setPixelColor(pixelIndex, strip.Color(0, 0, 0, 255));
-                else
-                    strip.setPixelColor(pixelIndex, 0);
+    animations[count] = animation;
+    animations[count].startMs = millis();
+    showLEDs();
+}
+
+// Draws one animation into frame at the given age; false once it has ended.
+// The timings are those of the old blocking versions.
+bool BoardDriver::drawAnimation(const Animation &animation, uint32_t elapsed, uint32_t frame[LED_COUNT]) {
+    switch (animation.type) {
+        case ANIM_FIREWORK: {
+            // Expansion, contraction and a second expansion, 12 steps of 100 ms each
+            uint32_t step = elapsed / 100;
+            if (step >= 36) return false;
+            float radius = (step / 12 == 1) ? 6 - 0.5f * (step % 12) : 0.5f * (step % 12);
+            for (int row = 0; row < 8; row++) {
+                for (int col = 0; col < 8; col++) {
+                    float dx = col - 3.5f;
+                    float dy = row - 3.5f;
+                    float dist = sqrt(dx * dx + dy * dy);
+                    frame[getPixelIndex(row, col)] = fabs(dist - radius) < 0.5f ? color(0, 0, 0, 255) : 0;
+                }
             }
+            return true;
         }
-        strip.show();
-        delay(100);
-    }
-    
-    // Second expansion phase:
-    for (float radius = 0; radius < 6; radius += 0.5) {
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                float dx = col - centerX;
-                float dy = row - centerY;
-                float dist = sqrt(dx * dx + dy * dy);
-                int pixelIndex = getPixelIndex(row, col);
-                if (fabs(dist - radius) < 0.5)
-                    strip.setPixelColor(pixelIndex, strip.Color(0, 0, 0, 255));
-                else
-                    strip.setPixelColor(pixelIndex, 0);
+        case ANIM_CAPTURE: {
+            // Three pulses of 150 ms, alternating red and orange
+            uint32_t pulse = elapsed / 150;
+            if (pulse >= 3) return false;
+            float pulseWidth = 1.5f + pulse;
+            uint32_t pulseColor = (pulse % 2 == 0) ? color(255, 0, 0, 0) : color(255, 165, 0, 0);
+            for (int row = 0; row < 8; row++) {
+                for (int col = 0; col < 8; col++) {
+                    float dx = col - 3.5f;
+                    float dy = row - 3.5f;
+                    float dist = sqrt(dx * dx + dy * dy);
+                    bool lit = dist >= pulseWidth - 0.5f && dist <= pulseWidth + 0.5f;
+                    frame[getPixelIndex(row, col)] = lit ? pulseColor : 0;
+                }
             }
+            return true;
         }
-        strip.show();
-        delay(100);
-    }
-    
-    // Clear all LEDs
-    clearAllLEDs();
-}
-
-void BoardDriver::captureAnimation() {
-    float centerX = 3.5;
-    float centerY = 3.5;
-    
-    // Pulsing outward animation
-    for (int pulse = 0; pulse < 3; pulse++) {
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                float dx = col - centerX;
-                float dy = row - centerY;
-                float dist = sqrt(dx * dx + dy * dy);
-                
-                // Create a pulsing effect around the center
-                float pulseWidth = 1.5 + pulse;
-                int pixelIndex = getPixelIndex(row, col);
-                
-                if (dist >= pulseWidth - 0.5 && dist <= pulseWidth + 0.5) {
-                    // Alternate between red and orange for capture effect
-                    uint32_t color = (pulse % 2 == 0) 
-                        ? strip.Color(255, 0, 0, 0)   // Red
-                        : strip.Color(255, 165, 0, 0); // Orange
-                    strip.setPixelColor(pixelIndex, color);
-                } else {
-                    strip.setPixelColor(pixelIndex, 0);
-                }
+        case ANIM_PROMOTION: {
+            // A golden wave moving along the column, 16 steps of 100 ms
+            uint32_t step = elapsed / 100;
+            if (step >= 16) return false;
+            int col = __builtin_ctzll(animation.squares);
+            for (int row = 0; row < 8; row++) {
+                frame[getPixelIndex(row, col)] = (step + row) % 8 < 4 ? color(255, 215, 0, 50) : 0;
             }
+            return true;
         }
-        strip.show();
-        delay(150);
-    }
-    
-    // Clear LEDs
-    clearAllLEDs();
-}
-
-void BoardDriver::promotionAnimation(int col) {
-    const uint32_t PROMOTION_COLOR = strip.Color(255, 215, 0, 50); // Gold with white
-    
-    // Column-based waterfall animation
-    for (int step = 0; step < 16; step++) {
-        for (int row = 0; row < 8; row++) {
-            int pixelIndex = getPixelIndex(row, col);
-            
-            // Create a golden wave moving up and down the column
-            if ((step + row) % 8 < 4) {
-                strip.setPixelColor(pixelIndex, PROMOTION_COLOR);
-            } else {
-                strip.setPixelColor(pixelIndex, 0);
+        case ANIM_FLASH: {
+            if (elapsed / animation.periodMs >= animation.times) return false;
+            bool on = elapsed % animation.periodMs < animation.periodMs / 2u;
+            if (!on && !animation.offDark) return true;
+            for (int square = 0; square < 64; square++) {
+                if ((animation.squares >> square) & 1) {
+                    frame[getPixelIndex(square >> 3, square & 7)] = on ? animation.color : 0;
+                }
             }
+            return true;
         }
-        strip.show();
-        delay(100);
     }
-    
-    // Clear the animation
-    for (int row = 0; row < 8; row++) {
-        int pixelIndex = getPixelIndex(row, col);
-        strip.setPixelColor(pixelIndex, 0);
-    }
-    strip.show();
+    return false;
 }
 
 bool BoardDriver::checkInitialBoard(const char initialBoard[8][8]) {
     readSensors();
-    bool allPresent = true;
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            if (initialBoard[row][col] != ' ' && !sensorState[row][col]) {
-                allPresent = false;
-            }
-        }
-    }
-    return allPresent;
+    return (occupancyOf(initialBoard) & ~sensorState) == 0;
 }
 
 void BoardDriver::updateSetupDisplay(const char initialBoard[8][8]) {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            int pixelIndex = getPixelIndex(row, col);
-            
-            // Check if a piece is detected on this square
-            if (sensorState[row][col]) {
-                // Determine color based on where the piece is placed
-                if (row <= 1) {
-                    // Black side (top, rows 0-1) - White LED for black pieces
-                    strip.setPixelColor(pixelIndex, strip.Color(0, 0, 0, 255)); // White
-                } else if (row >= 6) {
-                    // White side (bottom, rows 6-7) - Blue LED for white pieces
-                    strip.setPixelColor(pixelIndex, strip.Color(0, 0, 255)); // Blue
-                } else {
-                    // Middle rows (rows 2-5) - Red to indicate error (piece shouldn't be here)
-                    strip.setPixelColor(pixelIndex, strip.Color(255, 0, 0)); // Red
-                }
-            } else {
-                // No piece detected - turn off LED
-                strip.setPixelColor(pixelIndex, 0);
-            }
+    // Squares without a piece go dark; the rest are colored by where the piece
+    // is: rows 0-1 white, rows 6-7 blue, the middle rows red (piece shouldn't be here)
+    const uint64_t ROWS_0_1 = 0x000000000000FFFFULL;
+    const uint64_t ROWS_6_7 = 0xFFFF000000000000ULL;
+    for (int square = 0; square < 64; square++) {
+        uint64_t bit = 1ULL << square;
+        uint32_t color = 0;
+        if (sensorState & bit) {
+            if (ROWS_0_1 & bit) color = strip.Color(0, 0, 0, 255);     // White
+            else if (ROWS_6_7 & bit) color = strip.Color(0, 0, 255);   // Blue
+            else color = strip.Color(255, 0, 0);                       // Red
         }
+        setPixel(getPixelIndex(square >> 3, square & 7), color);
     }
-    strip.show();
+    showLEDs();
 }
 
 void BoardDriver::printBoardState(const char initialBoard[8][8]) {
@@ -307,7 +797,7 @@ void BoardDriver::printBoardState(const char initialBoard[8][8]) {
         for (int col = 0; col < 8; col++) {
             char displayChar = ' ';
             if (initialBoard[row][col] != ' ') {
-                displayChar = sensorState[row][col] ? initialBoard[row][col] : '-';
+                displayChar = getSensorState(row, col) ? initialBoard[row][col] : '-';
             }
             Serial.print("'");
             Serial.print(displayChar);
@@ -18,6 +18,7 @@
 #define NUM_COLS    8
 #define LED_COUNT   (NUM_ROWS * NUM_COLS)
 #define BRIGHTNESS  255  // LED brightness: 0-255 (0=off, 255=max). Current: 255 (100% max brightness)
+#define LED_FRAME_MS 16  // Minimum time between strip pushes; one takes ~2.5 ms with interrupts off
 
 // Shift Register (74HC594) Pins
 #define SER_PIN     2   // Serial data input (74HC594 pin 14)
@@ -27,6 +28,99 @@
 // Column Input Pins (D6..D13)
 #define COL_PINS {6, 7, 8, 9, 10, 11, 12, 13}
 
+// Fast GPIO path: on these cores SER/SRCLK/RCLK are driven through the GPIO
+// set/clear registers, which loads a row in a couple of microseconds instead
+// of ~250, and the columns are sampled with one input register read per port
+// instead of eight digitalRead calls. Other boards keep the Arduino calls.
+#if defined(ESP32) || defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED_RP2040)
+    #define SHIFT_FAST_IO
+#endif
+#define SHIFT_EDGE_NOPS     8       // Padding per clock edge; the fastest core is ~8 ns a write
+#define SHIFT_EDGE_US       10      // Bit-bang delay per clock edge until calibrated
+
+// ---------------------------
+// Sensor Scanner Configuration
+// ---------------------------
+#define SENSOR_SETTLE_US    100     // Row select to column read until calibrated
+#define SENSOR_SETTLE_MAX_US    200 // Calibration reference; no candidate above it
+#define SENSOR_CALIBRATION_FRAMES 16 // Identical frames a candidate timing must give
+#define SENSOR_EVENT_QUEUE  32      // Queued lift/place events (power of two)
+
+// Adaptive scan rate: rows are read back to back while anything on the board
+// is changing, a piece is held or a blocking read is waiting, and once it has
+// all been quiet for SENSOR_ACTIVE_HOLD_MS the scanner drops to one frame
+// per SENSOR_IDLE_FRAME_MS with no row selected in between
+#define SENSOR_IDLE_FRAME_MS    40
+#define SENSOR_ACTIVE_HOLD_MS   500
+
+// Debounce: a square only changes state after this many consecutive samples
+// (scanner frames or readSensors calls) disagree with it, 1 to 7. Lifts need
+// more than placements, so a piece sliding over a square's edge does not read
+// as picked up.
+#define SENSOR_LIFT_SAMPLES     3
+#define SENSOR_PLACE_SAMPLES    2
+#define SENSOR_DEBOUNCE_MAX     7   // Largest count the three counter planes hold
+
+// Background scanning: on ESP32 a FreeRTOS task steps the scanner one row
+// per RTOS tick (a frame every 8 ms), so blocking work in loop() such as an
+// HTTP request or an animation no longer stalls sensor input. Remove the
+// define to scan from loop() on ESP32 too.
+#if defined(ESP32)
+    #define SENSOR_BACKGROUND_SCAN
+#endif
+#define SENSOR_TASK_STACK       2048
+#define SENSOR_TASK_PRIORITY    2
+
+enum SensorEventType {
+    SENSOR_LIFT,
+    SENSOR_PLACE
+};
+
+struct SensorEvent {
+    uint8_t square;         // row * 8 + col
+    uint8_t type;           // SensorEventType
+    uint32_t timeMs;        // millis() when the frame that saw it completed
+};
+
+// A debounced frame as published by the scanning side, with the event queue
+// tail after that frame's events
+struct SensorSnapshot {
+    uint64_t occupancy;
+    uint8_t eventTail;
+};
+
+// ---------------------------
+// Animation Configuration
+// ---------------------------
+#define ANIMATION_SLOTS     6       // Animations playing at once; a new one replaces the oldest
+
+enum AnimationType {
+    ANIM_NONE,
+    ANIM_FIREWORK,          // Ring expanding, contracting, expanding again; whole board
+    ANIM_CAPTURE,           // Three red/orange pulses; whole board
+    ANIM_PROMOTION,         // Golden wave along one column
+    ANIM_FLASH              // A set of squares flashing a color
+};
+
+// One playing animation. It is drawn from its start time alone, so it keeps
+// its pace however irregularly the frames are composed.
+struct Animation {
+    uint8_t type;           // AnimationType
+    uint8_t times;          // ANIM_FLASH: number of flashes
+    bool offDark;           // ANIM_FLASH: off phase black rather than the layer below
+    uint16_t periodMs;      // ANIM_FLASH: one on + off cycle
+    uint32_t color;         // ANIM_FLASH
+    uint64_t squares;       // ANIM_FLASH: squares flashed; ANIM_PROMOTION: its column
+    uint32_t startMs;
+};
+
+// A pin resolved to its port's write-1-to-set and write-1-to-clear registers
+struct FastPin {
+    volatile uint32_t* set;
+    volatile uint32_t* clear;
+    uint32_t mask;
+};
+
 // ---------------------------
 // Board Driver Class
 // ---------------------------
@@ -35,11 +129,92 @@ private:
     Adafruit_NeoPixel strip;
     int colPins[NUM_COLS];
     byte rowPatterns[8];
-    bool sensorState[8][8];
-    bool sensorPrev[8][8];
+    uint64_t sensorState;           // Debounced occupancy, bit = row * 8 + col
+    uint64_t sensorPrev;            // sensorState at the last updateSensorPrev()
+    
+    // Scanning side, owned by the background task when there is one: the
+    // row being settled, the rows read so far and the debounced occupancy
+    int scanRow;                    // -1 when no row is selected
+    unsigned long scanSelectedAt;   // micros() of the row select
+    uint64_t scanFrame;
+    uint64_t scanStable;
+    uint16_t settleUs;              // Row select to column read
+    uint8_t shiftEdgeUs;            // Bit-bang delay per clock edge
+    bool scanFast;                  // Full rate, rather than one frame per SENSOR_IDLE_FRAME_MS
+    uint32_t scanActiveAt;          // millis() of the last sign of activity
+    uint32_t scanFrameAt;           // millis() the current frame started
+    
+    // Per-square run length of samples disagreeing with scanStable, as a
+    // 3-bit counter stored across three bitboards (plane b holds bit b)
+    uint64_t debounceCount[3];
+    uint8_t liftSamples;
+    uint8_t placeSamples;
+    
+    // Requests from the game side, which the scanning side applies at its
+    // next step so that only it touches the state above: a wake, and new
+    // debounce thresholds (lift | place << 8, 0 for none). The hold is only
+    // ever written by the game side.
+    uint8_t wakeRequest;
+    uint16_t debounceRequest;
+    bool scanHold;                  // The game side wants full rate regardless
+    
+    // Handoff to the game side: the published frame behind a sequence lock
+    // (snapshotSeq is odd while the scanner writes it, and counts two per
+    // frame), and edge events through a single-producer/single-consumer
+    // ring the scanner writes at eventTail and the game side reads at eventHead
+    SensorSnapshot snapshot;
+    uint32_t snapshotSeq;
+    uint32_t syncedSeq;             // snapshotSeq when sensorState was last synced
+    SensorEvent events[SENSOR_EVENT_QUEUE];
+    uint8_t eventHead;
+    uint8_t eventTail;
+    
+#ifdef SHIFT_FAST_IO
+    FastPin serIO, srclkIO, rclkIO;
+    
+    // Column inputs: the distinct input registers, and per column the
+    // register it is on and its bit there
+    const volatile uint32_t* columnPorts[NUM_COLS];
+    uint8_t columnPortCount;
+    uint8_t columnPort[NUM_COLS];
+    uint32_t columnMask[NUM_COLS];
+#endif
+    
+    // Base layer the game modes paint; setPixel only marks it dirty when a
+    // color actually changes. A push composes the animations over it and
+    // sends the pixels that differ from what the strip last showed.
+    uint32_t ledFrame[LED_COUNT];
+    uint32_t ledShown[LED_COUNT];
+    bool ledDirty;
+    unsigned long ledShownAt;
+    
+    Animation animations[ANIMATION_SLOTS];  // In start order, ANIM_NONE when free
+    
+    // Overlay squares (bit = row * 8 + col) repainted whenever the LEDs are cleared
+    uint64_t overlaySquares;
+    uint32_t overlayColor;
     
     void loadShiftRegister(byte data);
+    uint8_t readColumns();
+    uint64_t readFrame();
+    bool frameRepeats(uint64_t reference);
+    uint64_t debounce(uint64_t raw);
+    void publishFrame(uint64_t raw);
+    uint32_t scanStep();
+    void applyScanRequests();
+    void wakeScanner();
+    bool syncFrame(uint8_t &tail);
+#ifdef SENSOR_BACKGROUND_SCAN
+    void* scanTaskHandle;           // NULL until begin() starts the task
+    bool scanPause;                 // Set by the game side to borrow the matrix...
+    bool scanPaused;                // ...and acknowledged by the task
+    static void scanTask(void* driver);
+#endif
     int getPixelIndex(int row, int col);
+    void setPixel(int index, uint32_t color);
+    void startAnimation(const Animation &animation);
+    bool drawAnimation(const Animation &animation, uint32_t elapsed, uint32_t frame[LED_COUNT]);
+    void paintOverlay();
 
 public:
     BoardDriver();
@@ -49,17 +224,74 @@ public:
     bool getSensorPrev(int row, int col);
     void updateSensorPrev();
     
+    // Occupancy bitboards (bit = row * 8 + col, the engine's square numbering):
+    // what is on the board now, and what was lifted or placed since the last
+    // updateSensorPrev()
+    uint64_t getOccupancy() { return sensorState; }
+    uint64_t getLifted() { return sensorPrev & ~sensorState; }
+    uint64_t getPlaced() { return ~sensorPrev & sensorState; }
+    static uint64_t occupancyOf(const char board[8][8]);
+    
+    // Samples needed to accept a lift or a placement, clamped to 1..SENSOR_DEBOUNCE_MAX;
+    // 1 turns the debounce off
+    void setDebounce(uint8_t lift, uint8_t place);
+    
+    // Non-blocking scanning, for the sketch to call on every loop pass.
+    // Each call reads at most one row, once the settle time has passed
+    // since it was selected, then selects the next. When the eighth row is
+    // in, the frame becomes the sensor state and every square that changed
+    // is queued as a timestamped lift or place event; returns true then.
+    // With SENSOR_BACKGROUND_SCAN the task does the reading and scanTick()
+    // only picks up the latest frame; if the task could not be started,
+    // scanning falls back to this call and to readSensors().
+    // A blocking readSensors() re-bases the scanner on its own frame (or
+    // waits for a fresh one from the task) and drops queued events, since
+    // the code that called it has seen them.
+    bool scanTick();
+    bool pollEvent(SensorEvent &event);     // Oldest event first; false if none
+    void clearEvents();
+    
+    // Keeps the scanner at full rate, e.g. while a move is in progress
+    void setScanHold(bool hold);
+    
+    // Finds the shortest row settle time (and, on boards without the fast
+    // GPIO path, shift register edge delay) that still reproduces a frame
+    // read at the slowest timings SENSOR_CALIBRATION_FRAMES times in a row,
+    // and keeps it with a margin. Needs pieces on the board held still;
+    // returns false and keeps the current timings otherwise.
+    bool calibrateSettleTime();
+    uint16_t getSettleTime() { return settleUs; }
+    
     // LED Control
     void clearAllLEDs();
     void setSquareLED(int row, int col, uint32_t color);
     void setSquareLED(int row, int col, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0);
+    
+    // Pushes the LED frame if it changed, at most once per LED_FRAME_MS; a
+    // frame held back goes out on a later call (the sketch makes one every
+    // loop pass, blocking sensor reads make one too). Each push also
+    // advances the animations. flushLEDs() pushes a pending frame right
+    // away, for use before long blocking work.
     void showLEDs();
+    void flushLEDs();
+    static uint32_t color(uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) { return Adafruit_NeoPixel::Color(r, g, b, w); }
+    
+    // Overlay: a set of squares kept lit in one color underneath everything
+    // else. Setting it only touches the LEDs when the squares change, and
+    // clearAllLEDs() falls back to it instead of to black.
+    void setOverlay(uint64_t squares, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0);
+    void clearOverlay();
     
-    // Animation Functions
+    // Animation Functions. These start an animation and return at once; it
+    // plays over the base layer on the following pushes, so sensors and the
+    // web server keep running, and newer animations draw over older ones.
     void fireworkAnimation();
     void captureAnimation();
     void promotionAnimation(int col);
     void blinkSquare(int row, int col, int times = 3);
+    void warnSquare(int row, int col, int times = 3);
+    void flashSquares(uint64_t squares, uint32_t flashColor, int times, int periodMs, bool offDark = false);
+    bool isAnimating();
     void highlightSquare(int row, int col, uint32_t color);
     
     // Setup Functions
@@ -0,0 +1,119 @@
+#include "board_steps.h"
+#include "chess_codec.h"
+#include <Arduino.h>
+
+// ---------------------------
+// BoardSteps Implementation
+// ---------------------------
+
+BoardSteps::BoardSteps(BoardDriver* bd) : boardDriver(bd) {
+    count = index = 0;
+    lifted = false;
+    blinkState = false;
+    lastBlink = 0;
+}
+
+void BoardSteps::add(int from, int to) {
+    if (!pending()) count = index = 0;
+    if (count == BOARD_STEPS_MAX) return;
+    steps[count].from = from;
+    steps[count].to = to;
+    if (++count == index + 1) start();
+}
+
+void BoardSteps::addMove(Move move, const MoveUndo &undo, bool carryPiece) {
+    int from = moveFrom(move);
+    int to = moveTo(move);
+    bool isKing = (undo.movedPiece == 'K' || undo.movedPiece == 'k');
+    bool isPawn = (undo.movedPiece == 'P' || undo.movedPiece == 'p');
+
+    if (carryPiece) add(from, to);
+    if (isKing && (to - from == 2 || from - to == 2)) {
+        add(to > from ? from + 3 : from - 4, (from + to) / 2);
+    } else if (isPawn && to == undo.epSquare) {
+        add((from & ~7) | (to & 7), -1);
+    }
+}
+
+void BoardSteps::start() {
+    const Step &step = steps[index];
+    lifted = false;
+    blinkState = true;
+    lastBlink = millis();
+
+    if (step.to < 0) {
+        Serial.print("Remove the piece on ");
+        Serial.print((char)('a' + (step.from & 7)));
+        Serial.println((step.from >> 3) + 1);
+    } else if (step.to == step.from) {
+        Serial.print("Replace the piece on ");
+        Serial.print((char)('a' + (step.from & 7)));
+        Serial.println((step.from >> 3) + 1);
+    } else {
+        char text[MOVE_TEXT_SIZE];
+        formatUciMove(encodeMove(step.from, step.to, PROMOTE_NONE), text);
+        Serial.print("Please make the move ");
+        Serial.print(text);
+        Serial.println(" on the physical board...");
+    }
+    draw();
+}
+
+bool BoardSteps::follow() {
+    if (!pending()) return false;
+    boardDriver->setScanHold(true);
+
+    SensorEvent event;
+    while (pending() && boardDriver->pollEvent(event)) {
+        const Step &step = steps[index];
+        bool done = false;
+        if (!lifted && event.type == SENSOR_LIFT && event.square == step.from) {
+            lifted = true;
+            done = step.to < 0;
+        } else if (lifted && event.type == SENSOR_PLACE && event.square == step.to) {
+            done = true;
+        } else {
+            continue;
+        }
+
+        if (!done) draw();
+        else if (++index < count) start();
+    }
+
+    if (!pending()) {
+        boardDriver->setScanHold(false);
+        boardDriver->clearAllLEDs();
+        boardDriver->showLEDs();
+        return true;
+    }
+    if (!lifted && millis() - lastBlink > 500) {
+        blinkState = !blinkState;
+        lastBlink = millis();
+        draw();
+    }
+    return false;
+}
+
+void BoardSteps::draw() {
+    const Step &step = steps[index];
+    bool swap = step.to == step.from;
+
+    boardDriver->clearAllLEDs();
+    if (!lifted && blinkState) {
+        if (step.to < 0) boardDriver->setSquareLED(step.from >> 3, step.from & 7, 255, 0, 0);
+        else if (swap) boardDriver->setSquareLED(step.from >> 3, step.from & 7, 255, 215, 0, 50);
+        else boardDriver->setSquareLED(step.from >> 3, step.from & 7, 255, 255, 255, 255);
+    }
+    if (step.to >= 0 && (lifted || !swap)) {
+        if (swap) boardDriver->setSquareLED(step.to >> 3, step.to & 7, 255, 215, 0, 50);   // Gold: piece to put back
+        else boardDriver->setSquareLED(step.to >> 3, step.to & 7, 0, 0, 0, 255);           // Bright white using W channel
+    }
+    boardDriver->showLEDs();
+}
+
+// The position was changed some other way; drop the steps still owed
+void BoardSteps::cancel() {
+    if (!pending()) return;
+    count = index = 0;
+    boardDriver->setScanHold(false);
+}
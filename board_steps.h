@@ -0,0 +1,54 @@
+#ifndef BOARD_STEPS_H
+#define BOARD_STEPS_H
+
+#include "board_driver.h"
+#include "chess_engine.h"
+
+#define BOARD_STEPS_MAX     3       // A castling with its rook, or an en passant capture, plus one spare
+
+// ---------------------------
+// Board Steps Class
+// ---------------------------
+// Walks the player through changes the game has made and the physical board
+// has not, one step at a time, from the scanner's events: carry a piece from
+// one square to another, swap it for another piece (a step to its own
+// square), or with no destination just lift it off. The square to lift from
+// blinks until the piece is in hand; the destination stays lit. follow() is
+// called from a game mode's update(), so loop() keeps running meanwhile.
+class BoardSteps {
+private:
+    struct Step {
+        int from;
+        int to;         // -1: clear the square
+    };
+
+    BoardDriver* boardDriver;
+    Step steps[BOARD_STEPS_MAX];
+    int count;
+    int index;
+    bool lifted;
+    bool blinkState;
+    unsigned long lastBlink;
+
+    void start();
+    void draw();
+
+public:
+    BoardSteps(BoardDriver* bd);
+
+    // Queue one step; the first one queued starts at once
+    void add(int from, int to);
+
+    // Queue the steps that mirror a move made in the game. The piece itself
+    // needs carrying unless the player moved it; castling also moves the
+    // rook and en passant takes a pawn from another square.
+    void addMove(Move move, const MoveUndo &undo, bool carryPiece);
+
+    // Advances the steps from the pending sensor events; true once the last
+    // one has just been done
+    bool follow();
+    bool pending() { return index < count; }
+    void cancel();
+};
+
+#endif // BOARD_STEPS_H
@@ -0,0 +1,129 @@
+#include "chess_attacks.h"
+
+static const int KNIGHT_STEPS[8][2] = {{2,1}, {1,2}, {-1,2}, {-2,1},
+                                       {-2,-1}, {-1,-2}, {1,-2}, {2,-1}};
+static const int KING_STEPS[8][2] = {{1,0}, {-1,0}, {0,1}, {0,-1},
+                                     {1,1}, {1,-1}, {-1,1}, {-1,-1}};
+
+static inline uint64_t squareBit(int row, int col) {
+    return (uint64_t)1 << (row * 8 + col);
+}
+
+static inline bool onBoard(int row, int col) {
+    return row >= 0 && row < 8 && col >= 0 && col < 8;
+}
+
+static inline bool isSlider(char piece) {
+    char upper = (piece >= 'a') ? piece - 32 : piece;
+    return upper == 'R' || upper == 'B' || upper == 'Q';
+}
+
+// ---------------------------
+// AttackMap Implementation
+// ---------------------------
+
+AttackMap::AttackMap() {
+    for (int square = 0; square < 64; square++) {
+        pieces[square] = ' ';
+        pieceAttacks[square] = 0;
+    }
+    occupied[0] = occupied[1] = 0;
+    attacked[0] = attacked[1] = 0;
+}
+
+void AttackMap::reset(const char board[8][8]) {
+    for (int square = 0; square < 64; square++) {
+        pieces[square] = board[square >> 3][square & 7];
+        pieceAttacks[square] = computeAttacks(board, square);
+    }
+    rebuildSides();
+}
+
+void AttackMap::update(const char board[8][8]) {
+    uint64_t changed = 0;
+    for (int square = 0; square < 64; square++) {
+        if (board[square >> 3][square & 7] != pieces[square]) changed |= (uint64_t)1 << square;
+    }
+    if (changed == 0) return;
+
+    // Sliders that reached a changed square may now see further or less far;
+    // other pieces attack the same squares whatever the occupancy
+    uint64_t affected = changed;
+    uint64_t others = (occupied[0] | occupied[1]) & ~changed;
+    while (others) {
+        int square = __builtin_ctzll(others);
+        others &= others - 1;
+        if ((pieceAttacks[square] & changed) && isSlider(pieces[square])) affected |= (uint64_t)1 << square;
+    }
+
+    while (affected) {
+        int square = __builtin_ctzll(affected);
+        affected &= affected - 1;
+        pieces[square] = board[square >> 3][square & 7];
+        pieceAttacks[square] = computeAttacks(board, square);
+    }
+    rebuildSides();
+}
+
+uint64_t AttackMap::hanging(bool white) {
+    int us = white ? 0 : 1;
+    return occupied[us] & attacked[us ^ 1] & ~attacked[us];
+}
+
+uint64_t AttackMap::overlaySquares(ThreatOverlay overlay, bool white) {
+    switch (overlay) {
+        case OVERLAY_ATTACKED: return attackedBy(!white);
+        case OVERLAY_HANGING: return hanging(white);
+        default: return 0;
+    }
+}
+
+// Squares attacked by the piece on a square; sliders stop at (and include)
+// the first piece in each direction, so defended pieces count as attacked
+uint64_t AttackMap::computeAttacks(const char board[8][8], int square) {
+    int row = square >> 3, col = square & 7;
+    char piece = board[row][col];
+    if (piece == ' ') return 0;
+
+    bool white = (piece < 'a');
+    char upper = white ? piece : piece - 32;
+    uint64_t attacks = 0;
+
+    if (upper == 'P') {
+        int r = row + (white ? 1 : -1);
+        if (onBoard(r, col - 1)) attacks |= squareBit(r, col - 1);
+        if (onBoard(r, col + 1)) attacks |= squareBit(r, col + 1);
+    } else if (upper == 'N' || upper == 'K') {
+        const int (*steps)[2] = (upper == 'N') ? KNIGHT_STEPS : KING_STEPS;
+        for (int i = 0; i < 8; i++) {
+            int r = row + steps[i][0], c = col + steps[i][1];
+            if (onBoard(r, c)) attacks |= squareBit(r, c);
+        }
+    } else {
+        // First four king steps are the straight rays, the last four the diagonals
+        int first = (upper == 'B') ? 4 : 0;
+        int last = (upper == 'R') ? 4 : 8;
+        for (int d = first; d < last; d++) {
+            int r = row + KING_STEPS[d][0], c = col + KING_STEPS[d][1];
+            while (onBoard(r, c)) {
+                attacks |= squareBit(r, c);
+                if (board[r][c] != ' ') break;
+                r += KING_STEPS[d][0];
+                c += KING_STEPS[d][1];
+            }
+        }
+    }
+    return attacks;
+}
+
+void AttackMap::rebuildSides() {
+    occupied[0] = occupied[1] = 0;
+    attacked[0] = attacked[1] = 0;
+    for (int square = 0; square < 64; square++) {
+        char piece = pieces[square];
+        if (piece == ' ') continue;
+        int side = (piece < 'a') ? 0 : 1;
+        occupied[side] |= (uint64_t)1 << square;
+        attacked[side] |= pieceAttacks[square];
+    }
+}
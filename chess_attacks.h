@@ -0,0 +1,51 @@
+#ifndef CHESS_ATTACKS_H
+#define CHESS_ATTACKS_H
+
+#include <stdint.h>
+
+// Threat overlays a game mode can paint from the attack map
+enum ThreatOverlay {
+    OVERLAY_OFF = 0,
+    OVERLAY_ATTACKED = 1,   // Squares the opponent attacks
+    OVERLAY_HANGING = 2     // Own pieces attacked and not defended
+};
+
+// ---------------------------
+// Attack Map Class
+// ---------------------------
+// Squares attacked by each side as bitboards (bit = row * 8 + col, index
+// 0 = White), kept up to date as the board changes. The attack set of
+// every piece is stored, so an update only regenerates the pieces on
+// changed squares and the sliders whose rays cross them; everything else
+// is a few ORs.
+class AttackMap {
+private:
+    char pieces[64];            // Board as last seen, to find changed squares
+    uint64_t pieceAttacks[64];  // Squares attacked by the piece on each square
+    uint64_t occupied[2];
+    uint64_t attacked[2];
+
+    uint64_t computeAttacks(const char board[8][8], int square);
+    void rebuildSides();
+
+public:
+    AttackMap();
+
+    // Recompute everything from a new position
+    void reset(const char board[8][8]);
+
+    // Bring the map up to date after any change to the board (a move,
+    // promotion or edit); cost grows with the number of changed squares
+    void update(const char board[8][8]);
+
+    uint64_t attackedBy(bool white) { return attacked[white ? 0 : 1]; }
+    uint64_t piecesOf(bool white) { return occupied[white ? 0 : 1]; }
+
+    // Pieces of one side attacked by the other and not defended
+    uint64_t hanging(bool white);
+
+    // Squares to paint for an overlay, seen from the given side
+    uint64_t overlaySquares(ThreatOverlay overlay, bool white);
+};
+
+#endif // CHESS_ATTACKS_H
@@ -0,0 +1,67 @@
+#include "chess_batch.h"
+#include <string.h>
+
+// Worker threads only exist on hosts; the board validates on the caller
+#ifndef ARDUINO
+  #include <thread>
+  #include <vector>
+#endif
+
+// ---------------------------
+// BatchValidator Implementation
+// ---------------------------
+
+BatchValidator::BatchValidator(const ChessEngine* ce) : engine(ce) {
+}
+
+// Validates queries first..last-1; first must be a multiple of 32 so each
+// bitmap word is assembled in a register and written once
+void BatchValidator::validateRange(const MoveQuery queries[], int first, int last, uint32_t bitmap[]) const {
+    Position pos;
+    pos.halfmoveClock = 0;
+    pos.fullmoveNumber = 1;
+    pos.hash = 0;   // Legality never reads the hash or the clocks
+
+    for (int word = first; word < last; word += 32) {
+        int end = (last - word < 32) ? last : word + 32;
+        uint32_t bits = 0;
+        for (int i = word; i < end; i++) {
+            const MoveQuery &query = queries[i];
+            memcpy(pos.board, query.board, sizeof(pos.board));
+            pos.whiteToMove = query.whiteToMove;
+            pos.castling = query.castling;
+            pos.epSquare = query.epSquare;
+            if (engine->isLegalMove(pos, query.move)) bits |= 1UL << (i - word);
+        }
+        bitmap[word >> 5] = bits;
+    }
+}
+
+void BatchValidator::validate(const MoveQuery queries[], int count, uint32_t bitmap[]) const {
+    validateRange(queries, 0, count, bitmap);
+}
+
+#ifndef ARDUINO
+void BatchValidator::validateParallel(const MoveQuery queries[], int count, uint32_t bitmap[], int threads) const {
+    int slices = (count + BATCH_SLICE_SIZE - 1) / BATCH_SLICE_SIZE;
+    if (threads > slices) threads = slices;
+    if (threads <= 1) {
+        validateRange(queries, 0, count, bitmap);
+        return;
+    }
+
+    // Contiguous runs of whole slices keep each worker on its own memory
+    int slicesPerThread = (slices + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) {
+        int first = t * slicesPerThread * BATCH_SLICE_SIZE;
+        if (first >= count) break;
+        int last = first + slicesPerThread * BATCH_SLICE_SIZE;
+        if (last > count) last = count;
+        workers.emplace_back(&BatchValidator::validateRange, this, queries, first, last, bitmap);
+    }
+    int last = slicesPerThread * BATCH_SLICE_SIZE;
+    validateRange(queries, 0, last < count ? last : count, bitmap);
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+}
+#endif
@@ -0,0 +1,54 @@
+#ifndef CHESS_BATCH_H
+#define CHESS_BATCH_H
+
+#include <stdint.h>
+#include "chess_engine.h"
+
+// ---------------------------
+// Batch Configuration
+// ---------------------------
+// Queries per thread slice. 512 results fill 16 bitmap words, one 64-byte
+// cache line, so threads never write to the same line.
+#define BATCH_SLICE_SIZE    512
+
+// One move to check, stored next to the position it is played in so a
+// batch is read front to back in a single pass (70 bytes per query). The
+// move clocks play no part in legality and are left out.
+struct MoveQuery {
+    char board[8][8];
+    Move move;
+    bool whiteToMove;
+    uint8_t castling;       // CASTLE_* bits
+    int8_t epSquare;        // As in Position, -1 if none
+};
+
+// ---------------------------
+// Batch Validator Class
+// ---------------------------
+// Checks many (position, move) pairs per call for hub servers. The result
+// is a bitmap: bit (i & 31) of word i / 32 is set when query i is legal.
+// Shares the const engine, so any number of validators can run at once.
+class BatchValidator {
+private:
+    const ChessEngine* engine;
+
+    void validateRange(const MoveQuery queries[], int first, int last, uint32_t bitmap[]) const;
+
+public:
+    BatchValidator(const ChessEngine* ce);
+
+    // bitmap needs (count + 31) / 32 words
+    void validate(const MoveQuery queries[], int count, uint32_t bitmap[]) const;
+
+#ifndef ARDUINO
+    // Same result, with the batch split into slices over up to threads
+    // workers. Batches smaller than two slices run on the calling thread.
+    void validateParallel(const MoveQuery queries[], int count, uint32_t bitmap[], int threads) const;
+#endif
+
+    static bool isValid(const uint32_t bitmap[], int index) {
+        return (bitmap[index >> 5] >> (index & 31)) & 1;
+    }
+};
+
+#endif // CHESS_BATCH_H
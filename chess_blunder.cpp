@@ -0,0 +1,59 @@
+#include "chess_blunder.h"
+
+// ---------------------------
+// BlunderCheck Implementation
+// ---------------------------
+
+BlunderCheck::BlunderCheck(const ChessEngine* ce, ChessSearch* cs) : engine(ce), search(cs) {
+}
+
+BlunderReport BlunderCheck::check(const char board[8][8], bool whiteToMove, const ChessHistory &gameHistory,
+                                  Move played, uint32_t budgetMs) {
+    Position before;
+    engine->setupPosition(before, board, whiteToMove);
+    return check(before, gameHistory, played, budgetMs);
+}
+
+BlunderReport BlunderCheck::check(const Position &before, const ChessHistory &gameHistory,
+                                  Move played, uint32_t budgetMs) {
+    BlunderReport report;
+    report.loss = 0;
+    report.best = played;
+    report.refutation = MOVE_NONE;
+    report.square = moveTo(played);
+
+    SearchLimits limits;
+    limits.moveTimeMs = budgetMs / 2;
+    if (limits.moveTimeMs == 0) limits.moveTimeMs = 1;
+    limits.hardLimit = true;
+
+    int bestScore;
+    report.best = search->findBestMove(before, gameHistory, limits, bestScore);
+    if (report.best == played || report.best == MOVE_NONE) return report;
+
+    // Score the played move by searching the reply
+    pos = before;
+    history = gameHistory;
+    MoveUndo undo;
+    engine->makeMove(pos, played, undo);
+    history.push(pos.hash, pos.halfmoveClock == 0);
+
+    int replyScore;
+    report.refutation = search->findBestMove(pos, history, limits, replyScore);
+    if (report.refutation == MOVE_NONE) {
+        // No reply either means mate or stalemate, or a search cut short
+        Move replies[MAX_MOVES];
+        if (engine->generateLegalMoves(pos, replies) > 0) {
+            report.best = played;
+            return report;
+        }
+    }
+    report.loss = bestScore + replyScore;
+    if (report.loss < 0) report.loss = 0;   // Searches of different depths can disagree slightly
+
+    if (report.refutation != MOVE_NONE) {
+        int target = moveTo(report.refutation);
+        if (pos.board[target >> 3][target & 7] != ' ') report.square = target;
+    }
+    return report;
+}
@@ -0,0 +1,51 @@
+#ifndef CHESS_BLUNDER_H
+#define CHESS_BLUNDER_H
+
+#include "chess_engine.h"
+#include "chess_history.h"
+#include "chess_search.h"
+
+// ---------------------------
+// Blunder Check Configuration
+// ---------------------------
+#define BLUNDER_BUDGET_MS   50      // Both searches together, a hard bound; too short to notice before confirmation
+#define BLUNDER_MARGIN_CP   150     // Loss against the best move that counts as a blunder
+
+struct BlunderReport {
+    int loss;           // Centipawns given away compared with the best move, 0 if it was the best
+    Move best;          // Best move in the position before the played move
+    Move refutation;    // Opponent's best reply to the played move, MOVE_NONE if there is none
+    int square;         // Square to flash: the piece the refutation takes, else the moved piece
+};
+
+// ---------------------------
+// Blunder Check Class
+// ---------------------------
+// Compares a player's move with the best alternative using two short
+// searches: the position before the move for the best score, and the
+// position after it for the score the move actually keeps. Each search
+// gets half the budget, and the second is skipped when the player found
+// the best move. The budget holds even inside depth 1: a board too slow to
+// finish a search in it gets no verdict (a loss of 0) rather than a stall.
+class BlunderCheck {
+private:
+    const ChessEngine* engine;
+    ChessSearch* search;
+
+    // Position after the played move, with its history
+    Position pos;
+    ChessHistory history;
+
+public:
+    BlunderCheck(const ChessEngine* ce, ChessSearch* cs);
+
+    // board, whiteToMove and gameHistory describe the position before played
+    BlunderReport check(const char board[8][8], bool whiteToMove, const ChessHistory &gameHistory,
+                        Move played, uint32_t budgetMs = BLUNDER_BUDGET_MS);
+    BlunderReport check(const Position &before, const ChessHistory &gameHistory,
+                        Move played, uint32_t budgetMs = BLUNDER_BUDGET_MS);
+
+    static bool isBlunder(const BlunderReport &report) { return report.loss > BLUNDER_MARGIN_CP; }
+};
+
+#endif // CHESS_BLUNDER_H
@@ -1,9 +1,18 @@
 #include "chess_bot.h"
 #include <Arduino.h>
 
-ChessBot::ChessBot(BoardDriver* boardDriver, ChessEngine* chessEngine, BotDifficulty diff, bool playerWhite) {
+// Print an engine move in coordinate notation, e.g. e2e4
+static void printEngineMove(Move move) {
+    char text[MOVE_TEXT_SIZE];
+    formatUciMove(move, text);
+    Serial.print(text);
+}
+
+ChessBot::ChessBot(BoardDriver* boardDriver, ChessEngine* chessEngine, ChessSearch* chessSearch, BotDifficulty diff, bool playerWhite)
+    : blunderCheck(chessEngine, chessSearch), boardSteps(boardDriver) {
     _boardDriver = boardDriver;
     _chessEngine = chessEngine;
+    _chessSearch = chessSearch;
     difficulty = diff;
     playerIsWhite = playerWhite;
     
@@ -15,14 +24,21 @@ ChessBot::ChessBot(BoardDriver* boardDriver, ChessEngine* chessEngine, BotDiffic
         case BOT_EXPERT: settings = StockfishSettings::expert(); break;
     }
     
-    // Set initial turn: In chess, White always moves first
-    // If player is White, player goes first (isWhiteTurn = true)
-    // If player is Black, bot (White) goes first (isWhiteTurn = true)
-    isWhiteTurn = true;  // White always moves first in chess
+    // White always moves first in chess; if the player is Black the bot starts
+    _chessEngine->setupPosition(pos, INITIAL_BOARD, true);
     gameStarted = false;
     botThinking = false;
     wifiConnected = false;
     currentEvaluation = 0.0;
+    hintsEnabled = true;
+    threatOverlay = OVERLAY_HANGING;
+    blunderWarnings = false;
+    hintShown = false;
+    playerTurnStart = 0;
+    movedTo = -1;
+    movedCapture = ' ';
+    botMoved = false;
+    blunderPending = false;
 }
 
 void ChessBot::begin() {
@@ -40,6 +56,7 @@ void ChessBot::begin() {
         case BOT_EXPERT: Serial.println("Expert (Depth 16)"); break;
     }
     
+    _boardDriver->clearOverlay();
     _boardDriver->clearAllLEDs();
     _boardDriver->showLEDs();
     
@@ -51,67 +68,44 @@ void ChessBot::begin() {
         Serial.println("WiFi connected! Bot mode ready.");
         wifiConnected = true;
         
-        // Show success animation
-        for (int i = 0; i < 3; i++) {
-            _boardDriver->clearAllLEDs();
-            _boardDriver->showLEDs();
-            delay(200);
-            
-            // Light up entire board green briefly
-            for (int row = 0; row < 8; row++) {
-                for (int col = 0; col < 8; col++) {
-                    _boardDriver->setSquareLED(row, col, 0, 255, 0); // Green
-                }
-            }
-            _boardDriver->showLEDs();
-            delay(200);
-        }
+        // Show success animation: the whole board flashes green
+        _boardDriver->clearAllLEDs();
+        _boardDriver->flashSquares(~0ULL, BoardDriver::color(0, 255, 0), 3, 400, true);
         
         initializeBoard();
         waitForBoardSetup();
     } else {
-        Serial.println("Failed to connect to WiFi. Bot mode unavailable.");
+        Serial.println("Failed to connect to WiFi. Playing against the on-board engine.");
         wifiConnected = false;
         
-        // Show error animation (red flashing)
-        for (int i = 0; i < 5; i++) {
-            _boardDriver->clearAllLEDs();
-            _boardDriver->showLEDs();
-            delay(300);
-            
-            // Light up entire board red briefly
-            for (int row = 0; row < 8; row++) {
-                for (int col = 0; col < 8; col++) {
-                    _boardDriver->setSquareLED(row, col, 255, 0, 0); // Red
-                }
-            }
-            _boardDriver->showLEDs();
-            delay(300);
-        }
-        
+        // Show error animation: the whole board flashes red
         _boardDriver->clearAllLEDs();
-        _boardDriver->showLEDs();
+        _boardDriver->flashSquares(~0ULL, BoardDriver::color(255, 0, 0), 5, 600, true);
+        
+        initializeBoard();
+        waitForBoardSetup();
     }
 }
 
 void ChessBot::update() {
-    if (!wifiConnected) {
-        return; // No WiFi, can't play against bot
-    }
-    
     if (!gameStarted) {
         return; // Waiting for initial setup
     }
     
+    // The last move has to be mirrored on the board before play goes on
+    if (boardSteps.pending()) {
+        if (boardSteps.follow()) finishMove();
+        _boardDriver->updateSensorPrev();
+        return;
+    }
+    
     if (botThinking) {
         showBotThinking();
         return;
     }
     
-    _boardDriver->readSensors();
-    
     // Detect piece movements (player's turn)
-    bool isPlayerTurn = (playerIsWhite && isWhiteTurn) || (!playerIsWhite && !isWhiteTurn);
+    bool isPlayerTurn = (playerIsWhite == pos.whiteToMove);
     if (isPlayerTurn) {
         static unsigned long lastTurnDebug = 0;
         if (millis() - lastTurnDebug > 5000) {
@@ -123,160 +117,153 @@ void ChessBot::update() {
         static int selectedRow = -1, selectedCol = -1;
         static bool piecePickedUp = false;
         
-        // Check for piece pickup
-        if (!piecePickedUp) {
-            for (int row = 0; row < 8; row++) {
-                for (int col = 0; col < 8; col++) {
-                    if (!_boardDriver->getSensorState(row, col) && _boardDriver->getSensorPrev(row, col)) {
-                        // Check what piece was picked up
-                        char piece = board[row][col];
-                        
-                        if (piece != ' ') {
-                            // Player should only be able to move their own pieces
-                            bool isPlayerPiece = (playerIsWhite && piece >= 'A' && piece <= 'Z') || 
-                                                 (!playerIsWhite && piece >= 'a' && piece <= 'z');
-                            if (isPlayerPiece) {
-                            selectedRow = row;
-                            selectedCol = col;
-                            piecePickedUp = true;
-                            
-                            Serial.print("Player picked up ");
-                            Serial.print(playerIsWhite ? "WHITE" : "BLACK");
-                            Serial.print(" piece '");
-                            Serial.print(board[row][col]);
-                            Serial.print("' at ");
-                            Serial.print((char)('a' + col));
-                            Serial.print(8 - row);
-                            Serial.print(" (array position ");
-                            Serial.print(row);
-                            Serial.print(",");
-                            Serial.print(col);
-                            Serial.println(")");
-                            
-                            // Show selected square
-                            _boardDriver->setSquareLED(row, col, 255, 0, 0); // Red
-                            
-                            // Show possible moves
-                            int moveCount = 0;
-                            int moves[27][2];
-                            _chessEngine->getPossibleMoves(board, row, col, moveCount, moves);
-                            
-                            for (int i = 0; i < moveCount; i++) {
-                                _boardDriver->setSquareLED(moves[i][0], moves[i][1], 0, 0, 0, 255); // Bright white using W channel
-                            }
-                            _boardDriver->showLEDs();
-                            break;
-                            } else {
-                                // Player tried to pick up the wrong color piece
-                                Serial.print("ERROR: You tried to pick up ");
-                                Serial.print((piece >= 'A' && piece <= 'Z') ? "WHITE" : "BLACK");
-                                Serial.print(" piece '");
-                                Serial.print(piece);
-                                Serial.print("' at ");
-                                Serial.print((char)('a' + col));
-                                Serial.print(8 - row);
-                                Serial.print(". You can only move ");
-                                Serial.print(playerIsWhite ? "WHITE" : "BLACK");
-                                Serial.println(" pieces!");
-                                
-                                // Flash red to indicate error
-                                _boardDriver->blinkSquare(row, col, 3);
-                            }
-                        }
-                    }
-                }
-                if (piecePickedUp) break;
-            }
+        // Offer a hint once the player has been thinking for a while
+        if (playerTurnStart == 0) playerTurnStart = millis();
+        if (hintsEnabled && !hintShown && !piecePickedUp && millis() - playerTurnStart > HINT_IDLE_MS) {
+            showHint();
         }
         
-        // Check for piece placement
-        if (piecePickedUp) {
-            for (int row = 0; row < 8; row++) {
-                for (int col = 0; col < 8; col++) {
-                    if (_boardDriver->getSensorState(row, col) && !_boardDriver->getSensorPrev(row, col)) {
-                        // Check if piece was returned to its original position
-                        if (row == selectedRow && col == selectedCol) {
-                            // Piece returned to original position - cancel selection
-                            Serial.println("Piece returned to original position. Selection cancelled.");
-                            piecePickedUp = false;
-                            selectedRow = selectedCol = -1;
-                            
-                            // Clear all indicators
-                            _boardDriver->clearAllLEDs();
-                            _boardDriver->showLEDs();
-                            break;
-                        }
-                        
-                        // Piece placed somewhere else - validate move
-                        int moveCount = 0;
-                        int moves[27][2];
-                        _chessEngine->getPossibleMoves(board, selectedRow, selectedCol, moveCount, moves);
-                        
-                        bool validMove = false;
-                        for (int i = 0; i < moveCount; i++) {
-                            if (moves[i][0] == row && moves[i][1] == col) {
-                                validMove = true;
-                                break;
-                            }
-                        }
-                        
-                        if (validMove) {
-                            char piece = board[selectedRow][selectedCol];
-                            
-                            // Complete LED animations BEFORE API request
-                            processPlayerMove(selectedRow, selectedCol, row, col, piece);
-                            
-                            // Flash confirmation on destination square for player move
-                            confirmSquareCompletion(row, col);
-                            
-                            piecePickedUp = false;
-                            selectedRow = selectedCol = -1;
-                            
-                            // Switch to bot's turn
-                            // If player is White, bot is Black (isWhiteTurn = false)
-                            // If player is Black, bot is White (isWhiteTurn = true)
-                            isWhiteTurn = !playerIsWhite;
-                            botThinking = true;
-                            
-                            Serial.println("Player move completed. Bot thinking...");
-                            
-                            // Start bot move calculation
-                            makeBotMove();
-                        } else {
-                            Serial.println("Invalid move! Please try again.");
-                            _boardDriver->blinkSquare(row, col, 3); // Blink red for invalid move
-                            
-                            // Restore move indicators - piece is still selected
-                            _boardDriver->clearAllLEDs();
-                            
-                            // Show selected square again
-                            _boardDriver->setSquareLED(selectedRow, selectedCol, 255, 0, 0); // Red
-                            
-                            // Show possible moves again
-                            int moveCount = 0;
-                            int moves[27][2];
-                            _chessEngine->getPossibleMoves(board, selectedRow, selectedCol, moveCount, moves);
-                            
-                            for (int i = 0; i < moveCount; i++) {
-                                _boardDriver->setSquareLED(moves[i][0], moves[i][1], 0, 0, 0, 255); // Bright white using W channel
-                            }
-                            _boardDriver->showLEDs();
-                            
-                            Serial.println("Piece is still selected. Place it on a valid move or return it to its original position.");
-                        }
+        // Lifts from the scanner select a piece, placements complete the move.
+        // Stop once the move has handed the turn to the bot.
+        SensorEvent event;
+        while (playerIsWhite == pos.whiteToMove && _boardDriver->pollEvent(event)) {
+            int row = event.square >> 3;
+            int col = event.square & 7;
+            
+            if (!piecePickedUp && event.type == SENSOR_LIFT) {
+                // Check what piece was picked up
+                char piece = pos.board[row][col];
+
+                if (piece != ' ') {
+                    // Player should only be able to move their own pieces
+                    bool isPlayerPiece = (playerIsWhite && piece >= 'A' && piece <= 'Z') || 
+                                         (!playerIsWhite && piece >= 'a' && piece <= 'z');
+                    if (isPlayerPiece) {
+                    selectedRow = row;
+                    selectedCol = col;
+                    piecePickedUp = true;
+
+                    Serial.print("Player picked up ");
+                    Serial.print(playerIsWhite ? "WHITE" : "BLACK");
+                    Serial.print(" piece '");
+                    Serial.print(pos.board[row][col]);
+                    Serial.print("' at ");
+                    Serial.print((char)('a' + col));
+                    Serial.print(8 - row);
+                    Serial.print(" (array position ");
+                    Serial.print(row);
+                    Serial.print(",");
+                    Serial.print(col);
+                    Serial.println(")");
+
+                    // Show selected square (replacing any hint)
+                    _boardDriver->clearAllLEDs();
+                    _boardDriver->setSquareLED(row, col, 255, 0, 0); // Red
+
+                    // Show possible moves
+                    int moveCount = 0;
+                    int moves[27][2];
+                    _chessEngine->getPossibleMoves(pos, row, col, moveCount, moves);
+
+                    for (int i = 0; i < moveCount; i++) {
+                        _boardDriver->setSquareLED(moves[i][0], moves[i][1], 0, 0, 0, 255); // Bright white using W channel
+                    }
+                    _boardDriver->showLEDs();
+                    } else {
+                        // Player tried to pick up the wrong color piece
+                        Serial.print("ERROR: You tried to pick up ");
+                        Serial.print((piece >= 'A' && piece <= 'Z') ? "WHITE" : "BLACK");
+                        Serial.print(" piece '");
+                        Serial.print(piece);
+                        Serial.print("' at ");
+                        Serial.print((char)('a' + col));
+                        Serial.print(8 - row);
+                        Serial.print(". You can only move ");
+                        Serial.print(playerIsWhite ? "WHITE" : "BLACK");
+                        Serial.println(" pieces!");
+
+                        // Flash red to indicate error
+                        _boardDriver->blinkSquare(row, col, 3);
+                    }
+                }
+            } else if (piecePickedUp && event.type == SENSOR_PLACE) {
+                // Check if piece was returned to its original position
+                if (row == selectedRow && col == selectedCol) {
+                    // Piece returned to original position - cancel selection
+                    Serial.println("Piece returned to original position. Selection cancelled.");
+                    piecePickedUp = false;
+                    selectedRow = selectedCol = -1;
+
+                    // Clear all indicators
+                    _boardDriver->clearAllLEDs();
+                    _boardDriver->showLEDs();
+                    continue;
+                }
+
+                // Piece placed somewhere else - validate move
+                int moveCount = 0;
+                int moves[27][2];
+                _chessEngine->getPossibleMoves(pos, selectedRow, selectedCol, moveCount, moves);
+
+                bool validMove = false;
+                for (int i = 0; i < moveCount; i++) {
+                    if (moves[i][0] == row && moves[i][1] == col) {
+                        validMove = true;
                         break;
                     }
                 }
+
+                if (validMove) {
+                    char piece = pos.board[selectedRow][selectedCol];
+
+                    // Judge the move while the board still shows the position before it;
+                    // the search budget is small enough not to hold up the confirmation.
+                    // The warning follows the move's confirmation.
+                    if (blunderWarnings) {
+                        int promotion = _chessEngine->isPawnPromotion(piece, row) ? PROMOTE_QUEEN : PROMOTE_NONE;
+                        Move played = encodeMove(selectedRow * 8 + selectedCol, row * 8 + col, promotion);
+                        pendingBlunder = blunderCheck.check(pos, history, played);
+                        blunderPending = BlunderCheck::isBlunder(pendingBlunder);
+                    }
+
+                    // The move hands the turn to the bot, which starts thinking
+                    // once the move is confirmed
+                    processPlayerMove(selectedRow, selectedCol, row, col, piece);
+
+                    piecePickedUp = false;
+                    selectedRow = selectedCol = -1;
+                    playerTurnStart = 0;
+                    hintShown = false;
+                } else {
+                    Serial.println("Invalid move! Please try again.");
+                    _boardDriver->blinkSquare(row, col, 3); // Blink red for invalid move
+
+                    // Restore move indicators - piece is still selected
+                    _boardDriver->clearAllLEDs();
+
+                    // Show selected square again
+                    _boardDriver->setSquareLED(selectedRow, selectedCol, 255, 0, 0); // Red
+
+                    // Show possible moves again
+                    int moveCount = 0;
+                    int moves[27][2];
+                    _chessEngine->getPossibleMoves(pos, selectedRow, selectedCol, moveCount, moves);
+
+                    for (int i = 0; i < moveCount; i++) {
+                        _boardDriver->setSquareLED(moves[i][0], moves[i][1], 0, 0, 0, 255); // Bright white using W channel
+                    }
+                    _boardDriver->showLEDs();
+
+                    Serial.println("Piece is still selected. Place it on a valid move or return it to its original position.");
+                }
             }
         }
+        
+        // Scan at full rate while a piece is in hand
+        _boardDriver->setScanHold(piecePickedUp);
     } else {
         // Bot's turn - if player is Black, bot (White) goes first
-        if (!botThinking && !playerIsWhite && isWhiteTurn) {
-            // Bot plays White and it's White's turn
-            botThinking = true;
-            makeBotMove();
-        } else if (!botThinking && playerIsWhite && !isWhiteTurn) {
-            // Bot plays Black and it's Black's turn
+        if (!botThinking) {
             botThinking = true;
             makeBotMove();
         }
@@ -352,7 +339,7 @@ bool ChessBot::connectToWiFi() {
 #endif
 }
 
-String ChessBot::makeStockfishRequest(String fen) {
+String ChessBot::makeStockfishRequest(const char* fen) {
     WiFiSSLClient client;
     
 #if defined(ESP32) || defined(ESP8266)
@@ -373,17 +360,21 @@ String ChessBot::makeStockfishRequest(String fen) {
         Serial.println(settings.maxRetries);
         
         if (client.connect(STOCKFISH_API_URL, STOCKFISH_API_PORT)) {
-            // URL encode the FEN string
-            String encodedFen = urlEncode(fen);
-            
-            // Make HTTP GET request
-            String url = String(STOCKFISH_API_PATH) + "?fen=" + encodedFen + "&depth=" + String(settings.depth);
+            // Build the request line in place; the encoded FEN is at most
+            // three times as long as the FEN
+            char encodedFen[URL_ENCODED_SIZE(FEN_MAX_LENGTH)];
+            urlEncode(fen, encodedFen, sizeof(encodedFen));
+            char url[sizeof(STOCKFISH_API_PATH) + sizeof(encodedFen) + 24];
+            snprintf(url, sizeof(url), "%s?fen=%s&depth=%d", STOCKFISH_API_PATH, encodedFen, settings.depth);
             
             Serial.print("Request URL: ");
             Serial.println(url);
             
-            client.println("GET " + url + " HTTP/1.1");
-            client.println("Host: " + String(STOCKFISH_API_URL));
+            client.print("GET ");
+            client.print(url);
+            client.println(" HTTP/1.1");
+            client.print("Host: ");
+            client.println(STOCKFISH_API_URL);
             client.println("Connection: close");
             client.println();
             
@@ -575,12 +566,57 @@ bool ChessBot::parseStockfishResponse(String response, String &bestMove, float &
 void ChessBot::makeBotMove() {
     Serial.println("=== BOT MOVE CALCULATION ===");
     Serial.print("Bot is playing as: ");
-    Serial.println(isWhiteTurn ? "White" : "Black");
+    Serial.println(pos.whiteToMove ? "White" : "Black");
     
-    // Show thinking animation
+    // Show thinking animation; the request or search below blocks for a while
     showBotThinking();
+    _boardDriver->flushLEDs();
+    
+    // Ask Stockfish first and fall back to the on-board engine
+    int fromRow, fromCol, toRow, toCol;
+    bool haveMove = false;
+    if (wifiConnected) {
+        haveMove = requestStockfishMove(fromRow, fromCol, toRow, toCol);
+    }
+    if (!haveMove && gameStarted) {
+        haveMove = requestLocalMove(fromRow, fromCol, toRow, toCol);
+    }
+    if (!haveMove) {
+        botThinking = false;
+        return;
+    }
     
-    String fen = boardToFEN();
+    // Verify the move is from the correct color piece
+    // Bot plays White if player is Black, Bot plays Black if player is White
+    char piece = pos.board[fromRow][fromCol];
+    bool botPlaysWhite = !playerIsWhite;
+    bool isBotPiece = (botPlaysWhite && piece >= 'A' && piece <= 'Z') || 
+                      (!botPlaysWhite && piece >= 'a' && piece <= 'z');
+    
+    if (!isBotPiece) {
+        Serial.print("ERROR: Bot tried to move a ");
+        Serial.print((piece >= 'A' && piece <= 'Z') ? "WHITE" : "BLACK");
+        Serial.print(" piece, but bot plays ");
+        Serial.println(botPlaysWhite ? "WHITE" : "BLACK");
+        Serial.print("Piece at source: ");
+        Serial.println(piece);
+        botThinking = false;
+        return;
+    }
+    
+    if (piece == ' ') {
+        Serial.println("ERROR: Bot tried to move from an empty square!");
+        botThinking = false;
+        return;
+    }
+    
+    executeBotMove(fromRow, fromCol, toRow, toCol);
+    botThinking = false;
+}
+
+bool ChessBot::requestStockfishMove(int &fromRow, int &fromCol, int &toRow, int &toCol) {
+    char fen[FEN_MAX_LENGTH];
+    boardToFEN(fen);
     Serial.print("Sending FEN to Stockfish: ");
     Serial.println(fen);
     
@@ -609,48 +645,13 @@ void ChessBot::makeBotMove() {
             Serial.println(evaluation);
             Serial.println("============================");
             
-            int fromRow, fromCol, toRow, toCol;
-            if (parseMove(bestMove, fromRow, fromCol, toRow, toCol)) {
+            if (parseMove(bestMove.c_str(), bestMove.length(), fromRow, fromCol, toRow, toCol)) {
                 Serial.print("Bot calculated move: ");
                 Serial.println(bestMove);
-                
-                // Verify the move is from the correct color piece
-                // Bot plays White if player is Black, Bot plays Black if player is White
-                char piece = board[fromRow][fromCol];
-                bool botPlaysWhite = !playerIsWhite;
-                bool isBotPiece = (botPlaysWhite && piece >= 'A' && piece <= 'Z') || 
-                                  (!botPlaysWhite && piece >= 'a' && piece <= 'z');
-                
-                if (!isBotPiece) {
-                    Serial.print("ERROR: Bot tried to move a ");
-                    Serial.print((piece >= 'A' && piece <= 'Z') ? "WHITE" : "BLACK");
-                    Serial.print(" piece, but bot plays ");
-                    Serial.println(botPlaysWhite ? "WHITE" : "BLACK");
-                    Serial.print("Piece at source: ");
-                    Serial.println(piece);
-                    botThinking = false;
-                    return;
-                }
-                
-                if (piece == ' ') {
-                    Serial.println("ERROR: Bot tried to move from an empty square!");
-                    botThinking = false;
-                    return;
-                }
-                
-                executeBotMove(fromRow, fromCol, toRow, toCol);
-                
-                // Switch back to player's turn
-                // If player is White, isWhiteTurn = true; if player is Black, isWhiteTurn = false
-                isWhiteTurn = playerIsWhite;
-                botThinking = false;
-                
-                Serial.println("Bot move completed. Your turn!");
-            } else {
-                Serial.print("Failed to parse bot move: ");
-                Serial.println(bestMove);
-                botThinking = false;
+                return true;
             }
+            Serial.print("Failed to parse bot move: ");
+            Serial.println(bestMove);
         } else {
             Serial.println("Failed to parse Stockfish response");
             Serial.print("Response was: ");
@@ -659,153 +660,99 @@ void ChessBot::makeBotMove() {
             } else {
                 Serial.println(response);
             }
-            botThinking = false;
         }
     } else {
         Serial.println("No response from Stockfish API after all retries");
-        botThinking = false;
     }
+    return false;
 }
 
-String ChessBot::boardToFEN() {
-    String fen = "";
-    
-    // Board position - FEN expects rank 8 (black pieces) first, rank 1 (white pieces) last
-    // Our array: row 0 = rank 1 (white pieces at bottom), row 7 = rank 8 (black pieces at top)
-    // So we need to reverse the order: start from row 7 and go to row 0
-    for (int row = 7; row >= 0; row--) {
-        int emptyCount = 0;
-        for (int col = 0; col < 8; col++) {
-            if (board[row][col] == ' ') {
-                emptyCount++;
-            } else {
-                if (emptyCount > 0) {
-                    fen += String(emptyCount);
-                    emptyCount = 0;
-                }
-                fen += board[row][col];
-            }
-        }
-        if (emptyCount > 0) {
-            fen += String(emptyCount);
-        }
-        if (row > 0) fen += "/";
+bool ChessBot::requestLocalMove(int &fromRow, int &fromCol, int &toRow, int &toCol) {
+    Serial.println("Searching with the on-board engine...");
+    
+    unsigned long startTime = millis();
+    int score = 0;
+    SearchLimits limits;
+    limits.moveTimeMs = settings.localMoveTimeMs;
+    limits.nodeLimit = settings.localNodes;
+    limits.evalNoise = settings.localEvalNoise;
+    _chessSearch->setObserver(this);
+    Move move = _chessSearch->findBestMove(pos, history, limits, score);
+    _chessSearch->setObserver(0);
+    
+    if (move == MOVE_NONE) {
+        Serial.println(score < 0 ? "Checkmate - you win!" : "Stalemate - the game is drawn");
+        gameStarted = false;
+        return false;
     }
     
-    // Active color - when we call this for bot's move, isWhiteTurn is false (bot is Black)
-    // So we correctly indicate it's Black's turn
-    fen += isWhiteTurn ? " w" : " b";
-    
-    // Castling availability (simplified - assume all available initially)
-    fen += " KQkq";
-    
-    // En passant target square (simplified - assume none)
-    fen += " -";
-    
-    // Halfmove clock (simplified)
-    fen += " 0";
-    
-    // Fullmove number (simplified)
-    fen += " 1";
+    // Keep the evaluation White-relative, like the Stockfish one
+    currentEvaluation = pos.whiteToMove ? score : -score;
+    
+    fromRow = moveFrom(move) >> 3;
+    fromCol = moveFrom(move) & 7;
+    toRow = moveTo(move) >> 3;
+    toCol = moveTo(move) & 7;
+    
+    Serial.print("On-board engine move: ");
+    printEngineMove(move);
+    Serial.print(" (");
+    Serial.print(currentEvaluation / 100.0, 2);
+    Serial.print(" pawns, ");
+    Serial.print(_chessSearch->getNodes());
+    Serial.print(" nodes, depth ");
+    Serial.print(_chessSearch->getCompletedDepth());
+    Serial.print(" in ");
+    Serial.print(millis() - startTime);
+    Serial.println(" ms)");
+    return true;
+}
+
+void ChessBot::boardToFEN(char fen[FEN_MAX_LENGTH]) {
+    // Castling rights, en passant square and clocks come from the game
+    // itself, so Stockfish sees exactly the position on the board
+    _chessEngine->formatFEN(pos, fen);
     
     Serial.print("Generated FEN: ");
     Serial.println(fen);
     Serial.print("Active color: ");
-    Serial.println(isWhiteTurn ? "White" : "Black");
-    
-    return fen;
+    Serial.println(pos.whiteToMove ? "White" : "Black");
 }
 
-void ChessBot::fenToBoard(String fen) {
-    // Parse FEN string and update board state
+void ChessBot::fenToBoard(const char* fen) {
     // FEN format: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
-    // We only parse the board part (first part before space)
-    
-    int spacePos = fen.indexOf(' ');
-    if (spacePos > 0) {
-        fen = fen.substring(0, spacePos);
-    }
-    
-    // Clear board
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            board[row][col] = ' ';
-        }
-    }
-    
-    // Parse FEN ranks (rank 8 first, rank 1 last)
-    // FEN: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR"
-    // Our array: row 0 = rank 1, row 7 = rank 8
-    int rank = 7; // Start with rank 8 (row 7 in our array)
-    int col = 0;
-    
-    for (int i = 0; i < fen.length() && rank >= 0; i++) {
-        char c = fen.charAt(i);
-        
-        if (c == '/') {
-            // Next rank
-            rank--;
-            col = 0;
-        } else if (c >= '1' && c <= '8') {
-            // Empty squares
-            int emptyCount = c - '0';
-            col += emptyCount;
-        } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
-            // Piece
-            if (rank >= 0 && rank < 8 && col >= 0 && col < 8) {
-                board[rank][col] = c;
-                col++;
-            }
-        }
+    // A malformed FEN leaves the current position alone
+    Position parsed;
+    if (!_chessEngine->setupPositionFromFEN(parsed, fen)) {
+        Serial.println("Invalid FEN, board not updated");
+        return;
     }
+    pos = parsed;
+    history.reset(pos.hash, pos.halfmoveClock);
+    attacks.update(pos.board);
     
     Serial.println("Board updated from FEN");
     printCurrentBoard();
 }
 
-bool ChessBot::parseMove(String move, int &fromRow, int &fromCol, int &toRow, int &toCol) {
-    if (move.length() < 4) {
-        Serial.print("Move too short: ");
+bool ChessBot::parseMove(const char* move, int length, int &fromRow, int &fromCol, int &toRow, int &toCol) {
+    // Parse chess notation (e.g., "e2e4"); rank 1 is row 0 in our array.
+    // A promotion letter is accepted but the bot always promotes to a queen.
+    Move parsed = parseUciMove(move, length);
+    if (parsed == MOVE_NONE) {
+        Serial.print("Invalid move text: ");
         Serial.println(move);
         return false;
     }
     
-    // Parse chess notation (e.g., "e2e4")
-    // File (column): a-h -> 0-7
-    // Rank (row): 1-8 -> In our array: rank 1 = row 0, rank 8 = row 7
-    // So rank 1 -> row 0, rank 2 -> row 1, ..., rank 8 -> row 7
-    
-    char fromFile = move.charAt(0);
-    char fromRank = move.charAt(1);
-    char toFile = move.charAt(2);
-    char toRank = move.charAt(3);
-    
-    // Validate file characters
-    if (fromFile < 'a' || fromFile > 'h' || toFile < 'a' || toFile > 'h') {
-        Serial.println("Invalid file in move");
-        return false;
-    }
-    
-    // Validate rank characters
-    if (fromRank < '1' || fromRank > '8' || toRank < '1' || toRank > '8') {
-        Serial.println("Invalid rank in move");
-        return false;
-    }
-    
-    fromCol = fromFile - 'a';
-    fromRow = (fromRank - '0') - 1;  // Convert 1-8 to 0-7 (rank 1 = row 0)
-    toCol = toFile - 'a';
-    toRow = (toRank - '0') - 1;      // Convert 1-8 to 0-7
+    fromRow = moveFrom(parsed) >> 3;
+    fromCol = moveFrom(parsed) & 7;
+    toRow = moveTo(parsed) >> 3;
+    toCol = moveTo(parsed) & 7;
     
     // Debug coordinate conversion
     Serial.print("Move string: ");
-    Serial.println(move);
-    Serial.print("Parsed: ");
-    Serial.print(fromFile);
-    Serial.print(fromRank);
-    Serial.print(" -> ");
-    Serial.print(toFile);
-    Serial.print(toRank);
+    Serial.print(move);
     Serial.print(" | Array coords: (");
     Serial.print(fromRow);
     Serial.print(",");
@@ -815,32 +762,19 @@ bool ChessBot::parseMove(String move, int &fromRow, int &fromCol, int &toRow, in
     Serial.print(",");
     Serial.print(toCol);
     Serial.println(")");
-    
-    // Check for promotion
-    if (move.length() >= 5) {
-        char promotionPiece = move.charAt(4);
-        Serial.print("Promotion to: ");
-        Serial.println(promotionPiece);
-    }
-    
-    // Validate coordinates
-    bool valid = (fromRow >= 0 && fromRow < 8 && fromCol >= 0 && fromCol < 8 &&
-                  toRow >= 0 && toRow < 8 && toCol >= 0 && toCol < 8);
-    
-    if (!valid) {
-        Serial.println("Invalid coordinates after parsing");
-    }
-    
-    return valid;
+    return true;
 }
 
 void ChessBot::executeBotMove(int fromRow, int fromCol, int toRow, int toCol) {
-    char piece = board[fromRow][fromCol];
-    char capturedPiece = board[toRow][toCol];
+    char piece = pos.board[fromRow][fromCol];
+    int promotion = _chessEngine->isPawnPromotion(piece, toRow) ? PROMOTE_QUEEN : PROMOTE_NONE;
+    Move move = encodeMove(fromRow * 8 + fromCol, toRow * 8 + toCol, promotion);
     
     // Update board state
-    board[toRow][toCol] = piece;
-    board[fromRow][fromCol] = ' ';
+    MoveUndo undo;
+    _chessEngine->makeMove(pos, move, undo);
+    char capturedPiece = undo.capturedPiece;
+    recordMove();
     
     Serial.print("Bot wants to move piece from ");
     Serial.print((char)('a' + fromCol));
@@ -848,24 +782,49 @@ void ChessBot::executeBotMove(int fromRow, int fromCol, int toRow, int toCol) {
     Serial.print(" to ");
     Serial.print((char)('a' + toCol));
     Serial.println(8 - toRow);
-    Serial.println("Please make this move on the physical board...");
-    
-    // Show the move that needs to be made
-    showBotMoveIndicator(fromRow, fromCol, toRow, toCol);
-    
-    // Wait for user to physically complete the bot's move
-    waitForBotMoveCompletion(fromRow, fromCol, toRow, toCol);
-    
     if (capturedPiece != ' ') {
         Serial.print("Piece captured: ");
         Serial.println(capturedPiece);
-        _boardDriver->captureAnimation();
     }
     
-    // Flash confirmation on the destination square
-    confirmSquareCompletion(toRow, toCol);
-    
-    Serial.println("Bot move completed. Your turn!");
+    // The player makes the move on the physical board; update() follows along
+    queueMoveSteps(move, undo, true);
+}
+
+void ChessBot::showHint() {
+    hintShown = true;
+    
+    // One multi-PV search covers all hint moves. It runs from update(), so
+    // it gets a short budget of its own and keeps the board serviced meanwhile
+    SearchLimits limits;
+    limits.moveTimeMs = HINT_MOVE_TIME_MS;
+    SearchLine lines[HINT_LINES];
+    _chessSearch->setObserver(this);
+    int count = _chessSearch->analyze(pos, history, limits, lines, HINT_LINES);
+    _chessSearch->setObserver(0);
+    if (count == 0) return;
+    
+    Serial.println("=== HINT ===");
+    _boardDriver->clearAllLEDs();
+    for (int i = 0; i < count; i++) {
+        Serial.print(i + 1);
+        Serial.print(". ");
+        printEngineMove(lines[i].pv[0]);
+        Serial.print(" (");
+        Serial.print(lines[i].score / 100.0, 2);
+        Serial.print(")");
+        for (int j = 1; j < lines[i].pvLength; j++) {
+            Serial.print(" ");
+            printEngineMove(lines[i].pv[j]);
+        }
+        Serial.println();
+        
+        // Best move brightest; later lines dim by half each
+        int from = moveFrom(lines[i].pv[0]);
+        uint8_t level = 255 >> i;
+        _boardDriver->setSquareLED(from >> 3, from & 7, 0, level, level); // Cyan
+    }
+    _boardDriver->showLEDs();
 }
 
 void ChessBot::showBotThinking() {
@@ -900,12 +859,12 @@ void ChessBot::showConnectionStatus() {
 }
 
 void ChessBot::initializeBoard() {
-    // Copy initial board state
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            board[row][col] = INITIAL_BOARD[row][col];
-        }
-    }
+    // The mirrored start layout has its kings off the e-file, so the game
+    // starts without castling rights
+    _chessEngine->setupPosition(pos, INITIAL_BOARD, true);
+    history.reset(pos.hash, pos.halfmoveClock);
+    attacks.reset(pos.board);
+    _chessSearch->newGame();
 }
 
 void ChessBot::waitForBoardSetup() {
@@ -927,11 +886,13 @@ void ChessBot::waitForBoardSetup() {
 }
 
 void ChessBot::processPlayerMove(int fromRow, int fromCol, int toRow, int toCol, char piece) {
-    char capturedPiece = board[toRow][toCol];
+    int promotion = _chessEngine->isPawnPromotion(piece, toRow) ? PROMOTE_QUEEN : PROMOTE_NONE;
+    Move move = encodeMove(fromRow * 8 + fromCol, toRow * 8 + toCol, promotion);
     
     // Update board state
-    board[toRow][toCol] = piece;
-    board[fromRow][fromCol] = ' ';
+    MoveUndo undo;
+    _chessEngine->makeMove(pos, move, undo);
+    char capturedPiece = undo.capturedPiece;
     
     Serial.print("Player moved ");
     Serial.print(piece);
@@ -945,49 +906,82 @@ void ChessBot::processPlayerMove(int fromRow, int fromCol, int toRow, int toCol,
     if (capturedPiece != ' ') {
         Serial.print("Captured ");
         Serial.println(capturedPiece);
-        _boardDriver->captureAnimation();
     }
     
-    // Check for pawn promotion
-    if (_chessEngine->isPawnPromotion(piece, toRow)) {
-        char promotedPiece = _chessEngine->getPromotedPiece(piece);
-        board[toRow][toCol] = promotedPiece;
+    // Pawn promotion (makeMove already placed the queen)
+    if (promotion != PROMOTE_NONE) {
         Serial.print("Pawn promoted to ");
-        Serial.println(promotedPiece);
+        Serial.println(pos.board[toRow][toCol]);
         _boardDriver->promotionAnimation(toCol);
     }
+    
+    recordMove();
+    queueMoveSteps(move, undo, false);
 }
 
-String ChessBot::urlEncode(String str) {
-    String encoded = "";
-    char c;
-    char code0;
-    char code1;
-    
-    for (int i = 0; i < str.length(); i++) {
-        c = str.charAt(i);
-        if (c == ' ') {
-            encoded += "%20";
-        } else if (c == '/') {
-            encoded += "%2F";
-        } else if (isalnum(c)) {
-            encoded += c;
-        } else {
-            code1 = (c & 0xf) + '0';
-            if ((c & 0xf) > 9) {
-                code1 = (c & 0xf) - 10 + 'A';
-            }
-            c = (c >> 4) & 0xf;
-            code0 = c + '0';
-            if (c > 9) {
-                code0 = c - 10 + 'A';
-            }
-            encoded += '%';
-            encoded += code0;
-            encoded += code1;
-        }
+// The player mirrors the move on the physical board: the bot's move in full,
+// their own only where castling or en passant touches a second square
+void ChessBot::queueMoveSteps(Move move, const MoveUndo &undo, bool byBot) {
+    movedTo = moveTo(move);
+    movedCapture = undo.capturedPiece;
+    botMoved = byBot;
+    boardSteps.addMove(move, undo, byBot);
+    if (!boardSteps.pending()) finishMove();
+}
+
+// The move is on the board: confirm it and hand over the turn
+void ChessBot::finishMove() {
+    if (movedCapture != ' ') _boardDriver->captureAnimation();
+    
+    // Flash confirmation on the destination square
+    confirmSquareCompletion(movedTo >> 3, movedTo & 7);
+    if (blunderPending) {
+        warnBlunder(pendingBlunder);
+        blunderPending = false;
     }
-    return encoded;
+    
+    Serial.println(botMoved ? "Bot move completed. Your turn!" : "Player move completed. Bot thinking...");
+}
+
+void ChessBot::recordMove() {
+    history.push(pos.hash, pos.halfmoveClock == 0);
+    
+    if (history.isThreefoldRepetition()) {
+        Serial.println("Draw available: threefold repetition");
+    } else if (history.isFiftyMoveDraw()) {
+        Serial.println("Draw available: fifty-move rule");
+    }
+    
+    attacks.update(pos.board);
+    showThreats();
+}
+
+// Paints the overlay for the player's pieces; the LEDs only change when it does
+void ChessBot::showThreats() {
+    uint64_t squares = attacks.overlaySquares(threatOverlay, playerIsWhite);
+    if (threatOverlay == OVERLAY_HANGING) {
+        _boardDriver->setOverlay(squares, 255, 0, 0);   // Red: piece en prise
+    } else {
+        _boardDriver->setOverlay(squares, 40, 0, 0);    // Dim red: attacked square
+    }
+}
+
+void ChessBot::warnBlunder(const BlunderReport &report) {
+    Serial.print("Careful: that move gives away about ");
+    Serial.print(report.loss / 100.0, 1);
+    Serial.print(" pawns. Better was ");
+    printEngineMove(report.best);
+    if (report.refutation != MOVE_NONE) {
+        Serial.print(", the bot can answer ");
+        printEngineMove(report.refutation);
+    }
+    Serial.println();
+    _boardDriver->warnSquare(report.square >> 3, report.square & 7);
+}
+
+// Takes effect from the next move, so it is safe to call outside a game
+void ChessBot::setThreatOverlay(ThreatOverlay overlay) {
+    threatOverlay = overlay;
 }
 
 void ChessBot::showBotMoveIndicator(int fromRow, int fromCol, int toRow, int toCol) {
@@ -1004,50 +998,11 @@ void ChessBot::showBotMoveIndicator(int fromRow, int fromCol, int toRow, int toC
     _boardDriver->showLEDs();
 }
 
-void ChessBot::waitForBotMoveCompletion(int fromRow, int fromCol, int toRow, int toCol) {
-    bool piecePickedUp = false;
-    bool moveCompleted = false;
-    static unsigned long lastBlink = 0;
-    static bool blinkState = false;
-    
-    Serial.println("Waiting for you to complete the bot's move...");
-    
-    while (!moveCompleted) {
-        _boardDriver->readSensors();
-        
-        // Blink the source square
-        if (millis() - lastBlink > 500) {
-            _boardDriver->clearAllLEDs();
-            if (blinkState && !piecePickedUp) {
-                _boardDriver->setSquareLED(fromRow, fromCol, 255, 255,  255, 255); // Flash source - bright white using W channel
-            }
-            _boardDriver->setSquareLED(toRow, toCol, 0, 0, 0, 255);         // Always show destination - bright white using W channel
-            _boardDriver->showLEDs();
-            
-            blinkState = !blinkState;
-            lastBlink = millis();
-        }
-        
-        // Check if piece was picked up from source
-        if (!piecePickedUp && !_boardDriver->getSensorState(fromRow, fromCol)) {
-            piecePickedUp = true;
-            Serial.println("Bot piece picked up, now place it on the destination...");
-            
-            // Stop blinking source, just show destination
-            _boardDriver->clearAllLEDs();
-            _boardDriver->setSquareLED(toRow, toCol, 0, 0, 0, 255); // Bright white using W channel
-            _boardDriver->showLEDs();
-        }
-        
-        // Check if piece was placed on destination
-        if (piecePickedUp && _boardDriver->getSensorState(toRow, toCol)) {
-            moveCompleted = true;
-            Serial.println("Bot move completed on physical board!");
-        }
-        
-        delay(50);
-        _boardDriver->updateSensorPrev();
-    }
+// Every 1024 nodes of an on-board search: keeps the scanner queueing events
+// for update() and the animations playing (the push is rate-limited)
+void ChessBot::poll() {
+    _boardDriver->scanTick();
+    _boardDriver->showLEDs();
 }
 
 void ChessBot::confirmMoveCompletion() {
@@ -1056,33 +1011,11 @@ void ChessBot::confirmMoveCompletion() {
 }
 
 void ChessBot::confirmSquareCompletion(int row, int col) {
-    if (row >= 0 && col >= 0) {
-        // Flash specific square twice
-        for (int flash = 0; flash < 2; flash++) {
-            _boardDriver->setSquareLED(row, col, 0, 255, 0); // Green flash
-            _boardDriver->showLEDs();
-            delay(150);
-            
-            _boardDriver->clearAllLEDs();
-            _boardDriver->showLEDs();
-            delay(150);
-        }
-    } else {
-        // Flash entire board (fallback for when we don't have specific coords)
-        for (int flash = 0; flash < 2; flash++) {
-            for (int r = 0; r < 8; r++) {
-                for (int c = 0; c < 8; c++) {
-                    _boardDriver->setSquareLED(r, c, 0, 255, 0); // Green flash
-                }
-            }
-            _boardDriver->showLEDs();
-            delay(150);
-            
-            _boardDriver->clearAllLEDs();
-            _boardDriver->showLEDs();
-            delay(150);
-        }
-    }
+    // Flash the square green twice, or the entire board (fallback for when
+    // we don't have specific coords)
+    uint64_t squares = (row >= 0 && col >= 0) ? 1ULL << (row * 8 + col) : ~0ULL;
+    _boardDriver->clearAllLEDs();
+    _boardDriver->flashSquares(squares, BoardDriver::color(0, 255, 0), 2, 300);
 }
 
 void ChessBot::printCurrentBoard() {
@@ -1092,7 +1025,7 @@ void ChessBot::printCurrentBoard() {
         Serial.print(8 - row);
         Serial.print(" ");
         for (int col = 0; col < 8; col++) {
-            char piece = board[row][col];
+            char piece = pos.board[row][col];
             if (piece == ' ') {
                 Serial.print(". ");
             } else {
@@ -1130,18 +1063,24 @@ void ChessBot::setDifficulty(BotDifficulty diff) {
 void ChessBot::getBoardState(char boardState[8][8]) {
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
-            boardState[row][col] = board[row][col];
+            boardState[row][col] = pos.board[row][col];
         }
     }
 }
 
 void ChessBot::setBoardState(char newBoardState[8][8]) {
     Serial.println("Board state updated via WiFi edit");
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            board[row][col] = newBoardState[row][col];
-        }
-    }
+    // An edited position starts a fresh history, with the castling rights
+    // its king and rook placement allows
+    _chessEngine->setupPosition(pos, newBoardState, pos.whiteToMove);
+    history.reset(pos.hash, pos.halfmoveClock);
+    attacks.update(pos.board);
+    showThreats();
+    
+    // Steps still owed for the previous position no longer apply
+    boardSteps.cancel();
+    blunderPending = false;
+    
     // Update sensor previous state to match new board
     _boardDriver->readSensors();
     // Note: We might need to update FEN state if bot is active
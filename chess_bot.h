@@ -3,6 +3,12 @@
 
 #include "board_driver.h"
 #include "chess_engine.h"
+#include "chess_attacks.h"
+#include "chess_history.h"
+#include "chess_search.h"
+#include "chess_blunder.h"
+#include "board_steps.h"
+#include "chess_codec.h"
 #include "stockfish_settings.h"
 #include "arduino_secrets.h"
 
@@ -21,12 +27,21 @@
   #warning "WiFi not supported on this board - Chess Bot will not work"
 #endif
 
-class ChessBot {
+// Hint mode: once the player has been idle this long on their turn, light
+// the starting squares of the engine's best few moves
+#define HINT_IDLE_MS        30000
+#define HINT_LINES          3
+#define HINT_MOVE_TIME_MS   400     // Search budget of a hint, whatever the difficulty
+
+// Observes its own on-board searches (moves and hints) only to keep the
+// sensor scan and the LED animations running while the engine thinks
+class ChessBot : public SearchObserver {
 private:
     BoardDriver* _boardDriver;
     ChessEngine* _chessEngine;
+    ChessSearch* _chessSearch;
     
-    char board[8][8];
+    Position pos;       // Board, side to move, castling rights, en passant square and clocks
     const char INITIAL_BOARD[8][8] = {
         {'R','N','B','K','Q','B','N','R'},  // row 0 (rank 8 - black pieces at top)
         {'P','P','P','P','P','P','P','P'},  // row 1 (rank 7)
@@ -41,56 +56,92 @@ private:
     StockfishSettings settings;
     BotDifficulty difficulty;
     
-    bool isWhiteTurn;
     bool playerIsWhite;  // true = player plays White, false = player plays Black
     bool gameStarted;
     bool botThinking;
     bool wifiConnected;
     float currentEvaluation;  // Stockfish evaluation (in centipawns, positive = white advantage)
+    bool hintsEnabled;
+    bool hintShown;
+    unsigned long playerTurnStart;  // 0 until the player's turn is first seen
+    
+    // Position hashes since the start of the game, for draw detection
+    ChessHistory history;
+    
+    // Attacked squares of both sides, updated on every move for the overlay
+    AttackMap attacks;
+    ThreatOverlay threatOverlay;
+    
+    // Optional check of each player move against the best alternative
+    BlunderCheck blunderCheck;
+    bool blunderWarnings;
     
-    // FEN notation handling
-    String boardToFEN();
-    void fenToBoard(String fen);
+    // A move made in the game waits for the player to mirror it on the
+    // physical board; play goes on once the last step is done
+    BoardSteps boardSteps;
+    
+    // Confirmed when the steps are done: the destination square, the piece
+    // taken and, for the player's move, any blunder warning
+    int movedTo;
+    char movedCapture;
+    bool botMoved;
+    BlunderReport pendingBlunder;
+    bool blunderPending;
+    
+    // FEN notation handling (fixed buffers, no heap)
+    void boardToFEN(char fen[FEN_MAX_LENGTH]);
+    void fenToBoard(const char* fen);
     
     // WiFi and API
     bool connectToWiFi();
-    String makeStockfishRequest(String fen);
+    String makeStockfishRequest(const char* fen);
     bool parseStockfishResponse(String response, String &bestMove, float &evaluation);
     
     // Move handling
-    bool parseMove(String move, int &fromRow, int &fromCol, int &toRow, int &toCol);
+    bool parseMove(const char* move, int length, int &fromRow, int &fromCol, int &toRow, int &toCol);
     void executeBotMove(int fromRow, int fromCol, int toRow, int toCol);
     
-    // URL encoding helper
-    String urlEncode(String str);
-    
     // Game flow
     void initializeBoard();
     void waitForBoardSetup();
     void processPlayerMove(int fromRow, int fromCol, int toRow, int toCol, char piece);
+    void recordMove();
+    void queueMoveSteps(Move move, const MoveUndo &undo, bool byBot);
+    void finishMove();
     void makeBotMove();
+    bool requestStockfishMove(int &fromRow, int &fromCol, int &toRow, int &toCol);
+    bool requestLocalMove(int &fromRow, int &fromCol, int &toRow, int &toCol);
+    void showHint();
+    void showThreats();
+    void warnBlunder(const BlunderReport &report);
     void showBotThinking();
     void showConnectionStatus();
     void showBotMoveIndicator(int fromRow, int fromCol, int toRow, int toCol);
-    void waitForBotMoveCompletion(int fromRow, int fromCol, int toRow, int toCol);
     void confirmMoveCompletion();
     void confirmSquareCompletion(int row, int col);
     void printCurrentBoard();
     
 public:
-    ChessBot(BoardDriver* boardDriver, ChessEngine* chessEngine, BotDifficulty diff = BOT_MEDIUM, bool playerWhite = true);
+    ChessBot(BoardDriver* boardDriver, ChessEngine* chessEngine, ChessSearch* chessSearch, BotDifficulty diff = BOT_MEDIUM, bool playerWhite = true);
     void begin();
     void update();
     void setDifficulty(BotDifficulty diff);
+    void setHintsEnabled(bool enabled) { hintsEnabled = enabled; }
+    void setThreatOverlay(ThreatOverlay overlay);
+    void setBlunderWarnings(bool enabled) { blunderWarnings = enabled; }
     
     // Get current board state for WiFi display
     void getBoardState(char boardState[8][8]);
+    bool isWhiteToMove() { return pos.whiteToMove; }
     
     // Set board state for editing/corrections
     void setBoardState(char newBoardState[8][8]);
     
     // Get current evaluation
     float getEvaluation() { return currentEvaluation; }
+    
+    // SearchObserver
+    void poll();
 };
 
 #endif // CHESS_BOT_H
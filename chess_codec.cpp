@@ -0,0 +1,66 @@
+#include "chess_codec.h"
+
+// ---------------------------
+// Move Text
+// ---------------------------
+
+int formatUciMove(Move move, char* text) {
+    static const char PROMOTION_CHARS[] = " nbrq";
+    int from = moveFrom(move);
+    int to = moveTo(move);
+    int length = 0;
+    text[length++] = 'a' + (from & 7);
+    text[length++] = '1' + (from >> 3);
+    text[length++] = 'a' + (to & 7);
+    text[length++] = '1' + (to >> 3);
+    if (movePromotion(move) != PROMOTE_NONE) text[length++] = PROMOTION_CHARS[movePromotion(move)];
+    text[length] = '\0';
+    return length;
+}
+
+Move parseUciMove(const char* text, int length) {
+    if (length < 4 || length > 5 ||
+        text[0] < 'a' || text[0] > 'h' || text[1] < '1' || text[1] > '8' ||
+        text[2] < 'a' || text[2] > 'h' || text[3] < '1' || text[3] > '8') {
+        return MOVE_NONE;
+    }
+    int from = (text[1] - '1') * 8 + (text[0] - 'a');
+    int to = (text[3] - '1') * 8 + (text[2] - 'a');
+    int promotion = PROMOTE_NONE;
+    if (length == 5) {
+        switch (text[4]) {
+            case 'n': promotion = PROMOTE_KNIGHT; break;
+            case 'b': promotion = PROMOTE_BISHOP; break;
+            case 'r': promotion = PROMOTE_ROOK; break;
+            case 'q': promotion = PROMOTE_QUEEN; break;
+            default: return MOVE_NONE;
+        }
+    }
+    return encodeMove(from, to, promotion);
+}
+
+// ---------------------------
+// URL Encoding
+// ---------------------------
+
+int urlEncode(const char* text, char* encoded, int size) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    int length = 0;
+    for (; *text != '\0'; text++) {
+        unsigned char c = (unsigned char)*text;
+        bool plain = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        if (length + (plain ? 1 : 3) >= size) {
+            if (size > 0) encoded[0] = '\0';
+            return -1;
+        }
+        if (plain) {
+            encoded[length++] = c;
+        } else {
+            encoded[length++] = '%';
+            encoded[length++] = HEX_DIGITS[c >> 4];
+            encoded[length++] = HEX_DIGITS[c & 15];
+        }
+    }
+    encoded[length] = '\0';
+    return length;
+}
@@ -0,0 +1,31 @@
+#ifndef CHESS_CODEC_H
+#define CHESS_CODEC_H
+
+#include "chess_position.h"
+
+// ---------------------------
+// Text Codecs
+// ---------------------------
+// Moves and URL values as text, for the Stockfish API, the UCI front-end
+// and the web pages. Every codec writes into a caller buffer or reads a
+// (text, length) span, so nothing touches the heap and they can run on
+// every move without fragmenting it. FEN has the same kind of codec in
+// ChessEngine::formatFEN and ChessEngine::setupPositionFromFEN.
+
+#define MOVE_TEXT_SIZE      6       // "e7e8q" plus the NUL
+#define URL_ENCODED_SIZE(n) (3 * (n) + 1)  // Worst case for n characters, with the NUL
+
+// Coordinate notation, e.g. e2e4 or e7e8q. Returns the length written.
+int formatUciMove(Move move, char* text);
+
+// The first length characters of text in coordinate notation: four, or
+// five with a promotion letter. MOVE_NONE if malformed; legality is left
+// to the caller.
+Move parseUciMove(const char* text, int length);
+
+// Percent-encodes text as a URL query value: letters and digits are kept,
+// everything else becomes %XX. Returns the encoded length, or -1 with an
+// empty result when it would not fit in size bytes.
+int urlEncode(const char* text, char* encoded, int size);
+
+#endif // CHESS_CODEC_H
@@ -0,0 +1,61 @@
+#include "chess_context.h"
+
+// ---------------------------
+// GameContext Implementation
+// ---------------------------
+
+GameContext::GameContext(const ChessEngine* ce) : engine(ce) {
+    setStartPosition();
+}
+
+void GameContext::setStartPosition() {
+    setPositionFromFEN(START_POSITION_FEN);
+}
+
+void GameContext::setPosition(const char board[8][8], bool whiteToMove) {
+    engine->setupPosition(pos, board, whiteToMove);
+    history.reset(pos.hash, pos.halfmoveClock);
+}
+
+// On a malformed FEN the previous position is kept
+bool GameContext::setPositionFromFEN(const char* fen) {
+    Position parsed;
+    if (!engine->setupPositionFromFEN(parsed, fen)) return false;
+    pos = parsed;
+    history.reset(pos.hash, pos.halfmoveClock);
+    return true;
+}
+
+int GameContext::legalMoves(Move moves[]) {
+    return engine->generateLegalMoves(pos, moves);
+}
+
+bool GameContext::isLegal(Move move) {
+    return engine->isLegalMove(pos, move);
+}
+
+bool GameContext::playMove(Move move) {
+    if (!isLegal(move)) return false;
+    MoveUndo undo;
+    engine->makeMove(pos, move, undo);
+    history.push(pos.hash, pos.halfmoveClock == 0);
+    return true;
+}
+
+bool GameContext::isInCheck() {
+    return engine->isInCheck(pos, pos.whiteToMove);
+}
+
+bool GameContext::isCheckmate() {
+    Move moves[MAX_MOVES];
+    return legalMoves(moves) == 0 && isInCheck();
+}
+
+bool GameContext::isStalemate() {
+    Move moves[MAX_MOVES];
+    return legalMoves(moves) == 0 && !isInCheck();
+}
+
+bool GameContext::isDraw() {
+    return history.isThreefoldRepetition() || history.isFiftyMoveDraw();
+}
@@ -0,0 +1,47 @@
+#ifndef CHESS_CONTEXT_H
+#define CHESS_CONTEXT_H
+
+#include "chess_engine.h"
+#include "chess_history.h"
+
+#define START_POSITION_FEN  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+// ---------------------------
+// Game Context Class
+// ---------------------------
+// Everything that belongs to one game: the position and its history. The
+// engine it points at is shared and immutable, so a host process can keep
+// one context per board and validate or search them from a thread pool
+// without locks, as long as each context is used by one thread at a time.
+// Searching needs a ChessSearch per thread, not per game.
+class GameContext {
+private:
+    const ChessEngine* engine;
+
+public:
+    Position pos;
+    ChessHistory history;
+
+    GameContext(const ChessEngine* ce);
+
+    // Start a new game; the history restarts from the given position
+    void setStartPosition();
+    void setPosition(const char board[8][8], bool whiteToMove);
+    bool setPositionFromFEN(const char* fen);
+
+    // Legal moves in the current position
+    int legalMoves(Move moves[]);
+    bool isLegal(Move move);
+
+    // Play a move and record it in the history; illegal moves are rejected
+    // and leave the game unchanged
+    bool playMove(Move move);
+
+    // Game state checks
+    bool isInCheck();
+    bool isCheckmate();
+    bool isStalemate();
+    bool isDraw();      // Threefold repetition or fifty-move rule
+};
+
+#endif // CHESS_CONTEXT_H
@@ -1,5 +1,41 @@
 #include "chess_engine.h"
-#include <Arduino.h>
+
+// The engine also builds on Linux hosts; only printMove touches the Arduino core
+#ifdef ARDUINO
+  #include <Arduino.h>
+#else
+  #include <stdio.h>
+#endif
+
+// Step tables shared by move generation and attack detection. The first
+// four king steps are the straight rays, the last four the diagonals.
+static const int KNIGHT_STEPS[8][2] = {{2,1}, {1,2}, {-1,2}, {-2,1},
+                                       {-2,-1}, {-1,-2}, {1,-2}, {2,-1}};
+static const int KING_STEPS[8][2] = {{1,0}, {-1,0}, {0,1}, {0,-1},
+                                     {1,1}, {1,-1}, {-1,1}, {-1,-1}};
+
+// Castling rights kept when a piece moves from or to a square: touching a
+// king's or rook's home square gives up the rights that depend on it
+static uint8_t castlingKeptAfter(int square) {
+    switch (square) {
+        case 0:  return (uint8_t)~CASTLE_WHITE_QUEEN;                        // a1
+        case 4:  return (uint8_t)~(CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN);  // e1
+        case 7:  return (uint8_t)~CASTLE_WHITE_KING;                         // h1
+        case 56: return (uint8_t)~CASTLE_BLACK_QUEEN;                        // a8
+        case 60: return (uint8_t)~(CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN);  // e8
+        case 63: return (uint8_t)~CASTLE_BLACK_KING;                         // h8
+    }
+    return 0xFF;
+}
+
+// Whether a pawn of the side to move stands beside the pawn that just
+// skipped over epSquare, i.e. whether an en passant capture is possible
+static bool canCaptureEnPassant(const char board[8][8], int epSquare, bool whiteToMove) {
+    int row = (epSquare >> 3) + (whiteToMove ? -1 : 1);
+    int col = epSquare & 7;
+    char pawn = whiteToMove ? 'P' : 'p';
+    return (col > 0 && board[row][col - 1] == pawn) || (col < 7 && board[row][col + 1] == pawn);
+}
 
 // ---------------------------
 // ChessEngine Implementation
@@ -10,7 +46,7 @@ ChessEngine::ChessEngine() {
 }
 
 // Main move generation function
-void ChessEngine::getPossibleMoves(const char board[8][8], int row, int col, int &moveCount, int moves[][2]) {
+void ChessEngine::getPossibleMoves(const char board[8][8], int row, int col, int &moveCount, int moves[][2]) const {
     moveCount = 0;
     char piece = board[row][col];
     
@@ -43,8 +79,59 @@ void ChessEngine::getPossibleMoves(const char board[8][8], int row, int col, int
     }
 }
 
+void ChessEngine::getPossibleMoves(const Position &pos, int row, int col, int &moveCount, int moves[][2]) const {
+    getPossibleMoves(pos.board, row, col, moveCount, moves);
+    char piece = pos.board[row][col];
+    if (piece != ' ' && (getPieceColor(piece) == 'w') == pos.whiteToMove) {
+        addSpecialMoves(pos, row, col, moveCount, moves);
+    }
+}
+
+// En passant and castling for the side to move. Castling needs the king's
+// path empty and its start and middle squares unattacked; the landing
+// square is left to the usual check test.
+void ChessEngine::addSpecialMoves(const Position &pos, int row, int col, int &moveCount, int moves[][2]) const {
+    char piece = pos.board[row][col];
+    bool white = pos.whiteToMove;
+    
+    if ((piece == 'P' || piece == 'p') && pos.epSquare >= 0) {
+        int epRow = pos.epSquare >> 3, epCol = pos.epSquare & 7;
+        if (row == epRow + (white ? -1 : 1) && (col - epCol == 1 || epCol - col == 1)) {
+            moves[moveCount][0] = epRow;
+            moves[moveCount][1] = epCol;
+            moveCount++;
+        }
+        return;
+    }
+    
+    if (piece != (white ? 'K' : 'k')) return;
+    int homeRow = white ? 0 : 7;
+    uint8_t kingSide = white ? CASTLE_WHITE_KING : CASTLE_BLACK_KING;
+    uint8_t queenSide = white ? CASTLE_WHITE_QUEEN : CASTLE_BLACK_QUEEN;
+    if (row != homeRow || col != 4 || !(pos.castling & (kingSide | queenSide))) return;
+    
+    char enemy = white ? 'b' : 'w';
+    char rook = white ? 'R' : 'r';
+    if (isSquareAttacked(pos.board, row, 4, enemy)) return;
+    
+    if ((pos.castling & kingSide) && pos.board[row][7] == rook &&
+        pos.board[row][5] == ' ' && pos.board[row][6] == ' ' &&
+        !isSquareAttacked(pos.board, row, 5, enemy)) {
+        moves[moveCount][0] = row;
+        moves[moveCount][1] = 6;
+        moveCount++;
+    }
+    if ((pos.castling & queenSide) && pos.board[row][0] == rook &&
+        pos.board[row][1] == ' ' && pos.board[row][2] == ' ' && pos.board[row][3] == ' ' &&
+        !isSquareAttacked(pos.board, row, 3, enemy)) {
+        moves[moveCount][0] = row;
+        moves[moveCount][1] = 2;
+        moveCount++;
+    }
+}
+
 // Pawn move generation
-void ChessEngine::addPawnMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) {
+void ChessEngine::addPawnMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const {
     int direction = (pieceColor == 'w') ? 1 : -1;
     
     // One square forward
@@ -79,13 +166,11 @@ void ChessEngine::addPawnMoves(const char board[8][8], int row, int col, char pi
 }
 
 // Rook move generation
-void ChessEngine::addRookMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) {
-    int directions[4][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
-    
+void ChessEngine::addRookMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const {
     for (int d = 0; d < 4; d++) {
         for (int step = 1; step < 8; step++) {
-            int newRow = row + step * directions[d][0];
-            int newCol = col + step * directions[d][1];
+            int newRow = row + step * KING_STEPS[d][0];
+            int newCol = col + step * KING_STEPS[d][1];
             
             if (!isValidSquare(newRow, newCol)) break;
             
@@ -107,13 +192,10 @@ void ChessEngine::addRookMoves(const char board[8][8], int row, int col, char pi
 }
 
 // Knight move generation
-void ChessEngine::addKnightMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) {
-    int knightMoves[8][2] = {{2,1}, {1,2}, {-1,2}, {-2,1},
-                             {-2,-1}, {-1,-2}, {1,-2}, {2,-1}};
-    
+void ChessEngine::addKnightMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const {
     for (int i = 0; i < 8; i++) {
-        int newRow = row + knightMoves[i][0];
-        int newCol = col + knightMoves[i][1];
+        int newRow = row + KNIGHT_STEPS[i][0];
+        int newCol = col + KNIGHT_STEPS[i][1];
         
         if (isValidSquare(newRow, newCol)) {
             if (isSquareEmpty(board, newRow, newCol) || 
@@ -127,13 +209,11 @@ void ChessEngine::addKnightMoves(const char board[8][8], int row, int col, char
 }
 
 // Bishop move generation
-void ChessEngine::addBishopMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) {
-    int directions[4][2] = {{1,1}, {1,-1}, {-1,1}, {-1,-1}};
-    
-    for (int d = 0; d < 4; d++) {
+void ChessEngine::addBishopMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const {
+    for (int d = 4; d < 8; d++) {
         for (int step = 1; step < 8; step++) {
-            int newRow = row + step * directions[d][0];
-            int newCol = col + step * directions[d][1];
+            int newRow = row + step * KING_STEPS[d][0];
+            int newCol = col + step * KING_STEPS[d][1];
             
             if (!isValidSquare(newRow, newCol)) break;
             
@@ -155,19 +235,16 @@ void ChessEngine::addBishopMoves(const char board[8][8], int row, int col, char
 }
 
 // Queen move generation (combination of rook and bishop)
-void ChessEngine::addQueenMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) {
+void ChessEngine::addQueenMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const {
     addRookMoves(board, row, col, pieceColor, moveCount, moves);
     addBishopMoves(board, row, col, pieceColor, moveCount, moves);
 }
 
 // King move generation
-void ChessEngine::addKingMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) {
-    int kingMoves[8][2] = {{1,0}, {-1,0}, {0,1}, {0,-1},
-                           {1,1}, {1,-1}, {-1,1}, {-1,-1}};
-    
+void ChessEngine::addKingMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const {
     for (int i = 0; i < 8; i++) {
-        int newRow = row + kingMoves[i][0];
-        int newCol = col + kingMoves[i][1];
+        int newRow = row + KING_STEPS[i][0];
+        int newCol = col + KING_STEPS[i][1];
         
         if (isValidSquare(newRow, newCol)) {
             if (isSquareEmpty(board, newRow, newCol) || 
@@ -181,7 +258,7 @@ void ChessEngine::addKingMoves(const char board[8][8], int row, int col, char pi
 }
 
 // Helper function to check if a square is occupied by an opponent piece
-bool ChessEngine::isSquareOccupiedByOpponent(const char board[8][8], int row, int col, char pieceColor) {
+bool ChessEngine::isSquareOccupiedByOpponent(const char board[8][8], int row, int col, char pieceColor) const {
     char targetPiece = board[row][col];
     if (targetPiece == ' ') return false;
     
@@ -190,22 +267,22 @@ bool ChessEngine::isSquareOccupiedByOpponent(const char board[8][8], int row, in
 }
 
 // Helper function to check if a square is empty
-bool ChessEngine::isSquareEmpty(const char board[8][8], int row, int col) {
+bool ChessEngine::isSquareEmpty(const char board[8][8], int row, int col) const {
     return board[row][col] == ' ';
 }
 
 // Helper function to check if coordinates are within board bounds
-bool ChessEngine::isValidSquare(int row, int col) {
+bool ChessEngine::isValidSquare(int row, int col) const {
     return row >= 0 && row < 8 && col >= 0 && col < 8;
 }
 
 // Helper function to get piece color
-char ChessEngine::getPieceColor(char piece) {
+char ChessEngine::getPieceColor(char piece) const {
     return (piece >= 'a' && piece <= 'z') ? 'b' : 'w';
 }
 
 // Move validation
-bool ChessEngine::isValidMove(const char board[8][8], int fromRow, int fromCol, int toRow, int toCol) {
+bool ChessEngine::isValidMove(const char board[8][8], int fromRow, int fromCol, int toRow, int toCol) const {
     int moveCount = 0;
     int moves[28][2]; // Maximum possible moves for a queen
     
@@ -220,32 +297,574 @@ bool ChessEngine::isValidMove(const char board[8][8], int fromRow, int fromCol,
 }
 
 // Check if a pawn move results in promotion
-bool ChessEngine::isPawnPromotion(char piece, int targetRow) {
+bool ChessEngine::isPawnPromotion(char piece, int targetRow) const {
     if (piece == 'P' && targetRow == 7) return true;  // White pawn reaches 8th rank
     if (piece == 'p' && targetRow == 0) return true;  // Black pawn reaches 1st rank
     return false;
 }
 
 // Get the promoted piece (always queen for now)
-char ChessEngine::getPromotedPiece(char piece) {
+char ChessEngine::getPromotedPiece(char piece) const {
     return (piece == 'P') ? 'Q' : 'q';
 }
 
 // Utility function to print a move in readable format
-void ChessEngine::printMove(int fromRow, int fromCol, int toRow, int toCol) {
+void ChessEngine::printMove(int fromRow, int fromCol, int toRow, int toCol) const {
+#ifdef ARDUINO
     Serial.print((char)('a' + fromCol));
     Serial.print(fromRow + 1);
     Serial.print(" to ");
     Serial.print((char)('a' + toCol));
     Serial.println(toRow + 1);
+#else
+    printf("%c%d to %c%d\n", 'a' + fromCol, fromRow + 1, 'a' + toCol, toRow + 1);
+#endif
 }
 
 // Convert algebraic notation file (a-h) to column index (0-7)
-char ChessEngine::algebraicToCol(char file) {
+char ChessEngine::algebraicToCol(char file) const {
     return file - 'a';
 }
 
 // Convert algebraic notation rank (1-8) to row index (0-7)
-int ChessEngine::algebraicToRow(int rank) {
+int ChessEngine::algebraicToRow(int rank) const {
     return rank - 1;
+}
+
+// Zobrist keys are derived with splitmix64 instead of being stored, so the
+// engine needs no RAM table and no initialization order
+static uint64_t zobristKey(uint64_t index) {
+    uint64_t x = index + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Key for a piece standing on a square (0 for an empty square)
+uint64_t ChessEngine::hashPiece(char piece, int row, int col) const {
+    int index = pieceIndex(piece);
+    if (index < 0) return 0;
+    return zobristKey((uint64_t)(index * 64 + row * 8 + col));
+}
+
+// Key toggled when Black is to move
+uint64_t ChessEngine::hashSideToMove() const {
+    return zobristKey(12 * 64);
+}
+
+// Key of a set of castling rights, one key per right
+uint64_t ChessEngine::hashCastling(uint8_t rights) const {
+    uint64_t hash = 0;
+    for (int i = 0; i < 4; i++) {
+        if (rights & (1 << i)) hash ^= zobristKey(12 * 64 + 1 + i);
+    }
+    return hash;
+}
+
+// Key of an en passant square (by file), 0 for none
+uint64_t ChessEngine::hashEnPassant(int square) const {
+    if (square < 0) return 0;
+    return zobristKey(12 * 64 + 5 + (square & 7));
+}
+
+// Hash of the placement and side to move only
+uint64_t ChessEngine::computeHash(const char board[8][8], bool whiteToMove) const {
+    uint64_t hash = whiteToMove ? 0 : hashSideToMove();
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            hash ^= hashPiece(board[row][col], row, col);
+        }
+    }
+    return hash;
+}
+
+// Full hash of a position; makeMove keeps it up to date incrementally
+uint64_t ChessEngine::computeHash(const Position &pos) const {
+    return computeHash(pos.board, pos.whiteToMove) ^ hashCastling(pos.castling) ^ hashEnPassant(pos.epSquare);
+}
+
+// ---------------------------
+// Search Support
+// ---------------------------
+
+// Piece placed by a promotion code (PROMOTE_KNIGHT..PROMOTE_QUEEN)
+static char promotionPieceFor(int promotion, bool white) {
+    static const char PROMOTION_PIECES[] = {' ', 'N', 'B', 'R', 'Q'};
+    char piece = PROMOTION_PIECES[promotion];
+    return white ? piece : piece + 32;
+}
+
+// Rights whose king and rook still stand on their home squares
+uint8_t ChessEngine::castlingRightsFor(const char board[8][8]) {
+    uint8_t rights = 0;
+    if (board[0][4] == 'K') {
+        if (board[0][7] == 'R') rights |= CASTLE_WHITE_KING;
+        if (board[0][0] == 'R') rights |= CASTLE_WHITE_QUEEN;
+    }
+    if (board[7][4] == 'k') {
+        if (board[7][7] == 'r') rights |= CASTLE_BLACK_KING;
+        if (board[7][0] == 'r') rights |= CASTLE_BLACK_QUEEN;
+    }
+    return rights;
+}
+
+void ChessEngine::setupPosition(Position &pos, const char board[8][8], bool whiteToMove) const {
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            pos.board[row][col] = board[row][col];
+        }
+    }
+    pos.whiteToMove = whiteToMove;
+    pos.castling = castlingRightsFor(pos.board);
+    pos.epSquare = -1;
+    pos.halfmoveClock = 0;
+    pos.fullmoveNumber = 1;
+    pos.hash = computeHash(pos);
+}
+
+// Reads a FEN, or the first four fields of an EPD line. Missing castling
+// and en passant fields mean none; missing counters start at 0 and 1.
+// Rights the placement no longer allows and en passant squares no pawn
+// can capture on are dropped, so equal positions always read the same.
+// Returns false if malformed.
+bool ChessEngine::setupPositionFromFEN(Position &pos, const char* fen) const {
+    int row = 7;
+    int col = 0;
+    const char* p = fen;
+
+    while (*p == ' ') p++;
+    for (; *p != '\0' && *p != ' '; p++) {
+        char c = *p;
+        if (c == '/') {
+            if (col != 8 || row == 0) return false;
+            row--;
+            col = 0;
+        } else if (c >= '1' && c <= '8') {
+            for (int i = 0; i < c - '0'; i++) {
+                if (col >= 8) return false;
+                pos.board[row][col++] = ' ';
+            }
+        } else if (pieceIndex(c) >= 0) {
+            if (col >= 8) return false;
+            pos.board[row][col++] = c;
+        } else {
+            return false;
+        }
+    }
+    if (row != 0 || col != 8) return false;
+
+    while (*p == ' ') p++;
+    if (*p != 'w' && *p != 'b') return false;
+    pos.whiteToMove = (*p == 'w');
+    p++;
+    pos.castling = 0;
+    pos.epSquare = -1;
+    pos.halfmoveClock = 0;
+    pos.fullmoveNumber = 1;
+
+    while (*p == ' ') p++;
+    if (*p == '-') {
+        p++;
+    } else {
+        for (; *p != '\0' && *p != ' '; p++) {
+            switch (*p) {
+                case 'K': pos.castling |= CASTLE_WHITE_KING; break;
+                case 'Q': pos.castling |= CASTLE_WHITE_QUEEN; break;
+                case 'k': pos.castling |= CASTLE_BLACK_KING; break;
+                case 'q': pos.castling |= CASTLE_BLACK_QUEEN; break;
+                default: return false;
+            }
+        }
+    }
+    pos.castling &= castlingRightsFor(pos.board);
+
+    while (*p == ' ') p++;
+    if (*p == '-') {
+        p++;
+    } else if (*p >= 'a' && *p <= 'h' && (p[1] == '3' || p[1] == '6')) {
+        int square = (p[1] - '1') * 8 + (p[0] - 'a');
+        if (canCaptureEnPassant(pos.board, square, pos.whiteToMove)) pos.epSquare = square;
+        p += 2;
+    }
+
+    // Counters are optional (EPD has opcodes here instead)
+    while (*p == ' ') p++;
+    if (*p >= '0' && *p <= '9') {
+        int halfmoves = 0;
+        while (*p >= '0' && *p <= '9') halfmoves = halfmoves * 10 + (*p++ - '0');
+        pos.halfmoveClock = halfmoves > 255 ? 255 : halfmoves;
+        while (*p == ' ') p++;
+        int fullmoves = 0;
+        while (*p >= '0' && *p <= '9') fullmoves = fullmoves * 10 + (*p++ - '0');
+        if (fullmoves > 0) pos.fullmoveNumber = fullmoves > 65535 ? 65535 : fullmoves;
+    }
+
+    pos.hash = computeHash(pos);
+    return true;
+}
+
+// Decimal digits of value at text; returns how many were written
+static int formatNumber(char* text, unsigned value) {
+    char digits[6];
+    int count = 0;
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    for (int i = 0; i < count; i++) text[i] = digits[count - 1 - i];
+    return count;
+}
+
+// Canonical FEN of a position; returns its length
+int ChessEngine::formatFEN(const Position &pos, char* fen) const {
+    int length = 0;
+    for (int row = 7; row >= 0; row--) {
+        int empty = 0;
+        for (int col = 0; col < 8; col++) {
+            char piece = pos.board[row][col];
+            if (piece == ' ') {
+                empty++;
+                continue;
+            }
+            if (empty > 0) fen[length++] = '0' + empty;
+            empty = 0;
+            fen[length++] = piece;
+        }
+        if (empty > 0) fen[length++] = '0' + empty;
+        if (row > 0) fen[length++] = '/';
+    }
+
+    fen[length++] = ' ';
+    fen[length++] = pos.whiteToMove ? 'w' : 'b';
+    fen[length++] = ' ';
+    if (pos.castling == 0) fen[length++] = '-';
+    if (pos.castling & CASTLE_WHITE_KING) fen[length++] = 'K';
+    if (pos.castling & CASTLE_WHITE_QUEEN) fen[length++] = 'Q';
+    if (pos.castling & CASTLE_BLACK_KING) fen[length++] = 'k';
+    if (pos.castling & CASTLE_BLACK_QUEEN) fen[length++] = 'q';
+    fen[length++] = ' ';
+    if (pos.epSquare < 0) {
+        fen[length++] = '-';
+    } else {
+        fen[length++] = 'a' + (pos.epSquare & 7);
+        fen[length++] = '1' + (pos.epSquare >> 3);
+    }
+    fen[length++] = ' ';
+    length += formatNumber(fen + length, pos.halfmoveClock);
+    fen[length++] = ' ';
+    length += formatNumber(fen + length, pos.fullmoveNumber);
+    fen[length] = '\0';
+    return length;
+}
+
+void ChessEngine::packPosition(const char board[8][8], bool whiteToMove, PackedPosition &packed) {
+    for (int i = 0; i < 8; i++) packed.occupancy[i] = 0;
+    for (int i = 0; i < 16; i++) packed.pieces[i] = 0;
+    for (int i = 0; i < 3; i++) packed.reserved[i] = 0;
+    packed.flags = whiteToMove ? 0 : PACKED_BLACK_TO_MOVE;
+    packed.enPassant = 0;
+    packed.halfmoveClock = 0;
+    packed.fullmoveNumber[0] = 1;
+    packed.fullmoveNumber[1] = 0;
+
+    // A legal position has at most 32 pieces; any beyond that are dropped
+    int count = 0;
+    for (int square = 0; square < 64 && count < 32; square++) {
+        int index = pieceIndex(board[square >> 3][square & 7]);
+        if (index < 0) continue;
+        packed.occupancy[square >> 3] |= 1 << (square & 7);
+        packed.pieces[count >> 1] |= index << ((count & 1) * 4);
+        count++;
+    }
+}
+
+void ChessEngine::packPosition(const Position &pos, PackedPosition &packed) {
+    packPosition(pos.board, pos.whiteToMove, packed);
+    packed.flags |= pos.castling << PACKED_CASTLING_SHIFT;
+    packed.enPassant = pos.epSquare + 1;
+    packed.halfmoveClock = pos.halfmoveClock;
+    packed.fullmoveNumber[0] = pos.fullmoveNumber & 0xFF;
+    packed.fullmoveNumber[1] = pos.fullmoveNumber >> 8;
+}
+
+bool ChessEngine::unpackBoard(const PackedPosition &packed, char board[8][8], bool &whiteToMove) {
+    static const char PIECE_CHARS[] = "PNBRQKpnbrqk";
+    int count = 0;
+    for (int square = 0; square < 64; square++) {
+        char piece = ' ';
+        if ((packed.occupancy[square >> 3] >> (square & 7)) & 1) {
+            if (count >= 32) return false;
+            int index = (packed.pieces[count >> 1] >> ((count & 1) * 4)) & 0x0F;
+            if (index >= 12) return false;
+            piece = PIECE_CHARS[index];
+            count++;
+        }
+        board[square >> 3][square & 7] = piece;
+    }
+    whiteToMove = (packed.flags & PACKED_BLACK_TO_MOVE) == 0;
+    return true;
+}
+
+bool ChessEngine::unpackPosition(const PackedPosition &packed, Position &pos) const {
+    if (!unpackBoard(packed, pos.board, pos.whiteToMove)) return false;
+    pos.castling = ((packed.flags >> PACKED_CASTLING_SHIFT) & 0x0F) & castlingRightsFor(pos.board);
+    pos.epSquare = -1;
+    int epSquare = packed.enPassant - 1;
+    int epRow = epSquare >> 3;
+    if (epSquare >= 0 && epSquare < 64 && (epRow == 2 || epRow == 5) &&
+        canCaptureEnPassant(pos.board, epSquare, pos.whiteToMove)) {
+        pos.epSquare = epSquare;
+    }
+    pos.halfmoveClock = packed.halfmoveClock;
+    pos.fullmoveNumber = packed.fullmoveNumber[0] | (packed.fullmoveNumber[1] << 8);
+    if (pos.fullmoveNumber == 0) pos.fullmoveNumber = 1;
+    pos.hash = computeHash(pos);
+    return true;
+}
+
+// Two lowercase hex digits per byte, in struct order, NUL-terminated
+void ChessEngine::packedToHex(const PackedPosition &packed, char* hex) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    const uint8_t* bytes = (const uint8_t*)&packed;
+    for (int i = 0; i < PACKED_POSITION_SIZE; i++) {
+        hex[2 * i] = HEX_DIGITS[bytes[i] >> 4];
+        hex[2 * i + 1] = HEX_DIGITS[bytes[i] & 0x0F];
+    }
+    hex[PACKED_HEX_LENGTH] = '\0';
+}
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool ChessEngine::packedFromHex(const char* hex, PackedPosition &packed) {
+    uint8_t* bytes = (uint8_t*)&packed;
+    for (int i = 0; i < PACKED_POSITION_SIZE; i++) {
+        int high = hexDigit(hex[2 * i]);
+        int low = high < 0 ? -1 : hexDigit(hex[2 * i + 1]);
+        if (low < 0) return false;
+        bytes[i] = (uint8_t)((high << 4) | low);
+    }
+    return true;
+}
+
+// Pseudo-legal moves for the side to move, built on getPossibleMoves.
+// Promotions are expanded to all four pieces, queen first.
+int ChessEngine::generateMoves(const Position &pos, Move moves[]) const {
+    int count = 0;
+    char side = pos.whiteToMove ? 'w' : 'b';
+    int targets[28][2];
+    
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            char piece = pos.board[row][col];
+            if (piece == ' ' || getPieceColor(piece) != side) continue;
+            
+            int targetCount = 0;
+            getPossibleMoves(pos, row, col, targetCount, targets);
+            
+            int from = row * 8 + col;
+            for (int i = 0; i < targetCount; i++) {
+                int to = targets[i][0] * 8 + targets[i][1];
+                if (isPawnPromotion(piece, targets[i][0])) {
+                    for (int promotion = PROMOTE_QUEEN; promotion >= PROMOTE_KNIGHT; promotion--) {
+                        moves[count++] = encodeMove(from, to, promotion);
+                    }
+                } else {
+                    moves[count++] = encodeMove(from, to);
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Filters pseudo-legal moves down to those that do not leave the king in check
+int ChessEngine::generateLegalMoves(Position &pos, Move moves[]) const {
+    int count = generateMoves(pos, moves);
+    bool white = pos.whiteToMove;
+    int legalCount = 0;
+    
+    for (int i = 0; i < count; i++) {
+        MoveUndo undo;
+        makeMove(pos, moves[i], undo);
+        if (!isInCheck(pos, white)) {
+            moves[legalCount++] = moves[i];
+        }
+        unmakeMove(pos, moves[i], undo);
+    }
+    return legalCount;
+}
+
+// Legality of one move without generating the whole move list: only the
+// moving piece's targets are generated, then the move is tried for check.
+// Pawn moves to the last rank must carry a promotion piece.
+bool ChessEngine::isLegalMove(Position &pos, Move move) const {
+    int fromRow = moveFrom(move) >> 3, fromCol = moveFrom(move) & 7;
+    int toRow = moveTo(move) >> 3, toCol = moveTo(move) & 7;
+    char piece = pos.board[fromRow][fromCol];
+    if (piece == ' ' || (getPieceColor(piece) == 'w') != pos.whiteToMove) return false;
+    
+    int promotion = movePromotion(move);
+    if (promotion > PROMOTE_QUEEN) return false;
+    if (isPawnPromotion(piece, toRow) != (promotion != PROMOTE_NONE)) return false;
+    
+    int targetCount = 0;
+    int targets[28][2];
+    getPossibleMoves(pos, fromRow, fromCol, targetCount, targets);
+    bool found = false;
+    for (int i = 0; i < targetCount && !found; i++) {
+        found = targets[i][0] == toRow && targets[i][1] == toCol;
+    }
+    if (!found) return false;
+    
+    bool white = pos.whiteToMove;
+    MoveUndo undo;
+    makeMove(pos, move, undo);
+    bool legal = !isInCheck(pos, white);
+    unmakeMove(pos, move, undo);
+    return legal;
+}
+
+void ChessEngine::makeMove(Position &pos, Move move, MoveUndo &undo) const {
+    int from = moveFrom(move), to = moveTo(move);
+    int fromRow = from >> 3, fromCol = from & 7;
+    int toRow = to >> 3, toCol = to & 7;
+    bool white = pos.whiteToMove;
+    
+    char piece = pos.board[fromRow][fromCol];
+    char captured = pos.board[toRow][toCol];
+    char placed = piece;
+    if (movePromotion(move) != PROMOTE_NONE) {
+        placed = promotionPieceFor(movePromotion(move), white);
+    }
+    bool isPawn = (piece == 'P' || piece == 'p');
+    
+    undo.movedPiece = piece;
+    undo.castling = pos.castling;
+    undo.epSquare = pos.epSquare;
+    undo.halfmoveClock = pos.halfmoveClock;
+    undo.hash = pos.hash;
+    
+    uint64_t hash = pos.hash ^ hashSideToMove() ^ hashCastling(pos.castling) ^ hashEnPassant(pos.epSquare);
+    
+    if (isPawn && to == pos.epSquare) {
+        // En passant: the captured pawn stands beside the target square
+        captured = pos.board[fromRow][toCol];
+        pos.board[fromRow][toCol] = ' ';
+        hash ^= hashPiece(captured, fromRow, toCol);
+    } else {
+        hash ^= hashPiece(captured, toRow, toCol);
+    }
+    undo.capturedPiece = captured;
+    
+    hash ^= hashPiece(piece, fromRow, fromCol) ^ hashPiece(placed, toRow, toCol);
+    pos.board[toRow][toCol] = placed;
+    pos.board[fromRow][fromCol] = ' ';
+    
+    // Castling: the rook jumps over the king
+    if ((piece == 'K' || piece == 'k') && (toCol - fromCol == 2 || fromCol - toCol == 2)) {
+        int rookFrom = toCol > fromCol ? 7 : 0;
+        int rookTo = toCol > fromCol ? 5 : 3;
+        char rook = pos.board[fromRow][rookFrom];
+        pos.board[fromRow][rookTo] = rook;
+        pos.board[fromRow][rookFrom] = ' ';
+        hash ^= hashPiece(rook, fromRow, rookFrom) ^ hashPiece(rook, fromRow, rookTo);
+    }
+    
+    pos.castling &= castlingKeptAfter(from) & castlingKeptAfter(to);
+    pos.epSquare = -1;
+    if (isPawn && (toRow - fromRow == 2 || fromRow - toRow == 2)) {
+        int skipped = ((fromRow + toRow) / 2) * 8 + fromCol;
+        if (canCaptureEnPassant(pos.board, skipped, !white)) pos.epSquare = skipped;
+    }
+    pos.halfmoveClock = (isPawn || captured != ' ') ? 0 : (pos.halfmoveClock < 255 ? pos.halfmoveClock + 1 : 255);
+    if (!white) pos.fullmoveNumber++;
+    pos.whiteToMove = !white;
+    pos.hash = hash ^ hashCastling(pos.castling) ^ hashEnPassant(pos.epSquare);
+}
+
+void ChessEngine::unmakeMove(Position &pos, Move move, const MoveUndo &undo) const {
+    int from = moveFrom(move), to = moveTo(move);
+    int fromRow = from >> 3, fromCol = from & 7;
+    int toRow = to >> 3, toCol = to & 7;
+    char piece = undo.movedPiece;
+    
+    pos.board[fromRow][fromCol] = piece;
+    if ((piece == 'P' || piece == 'p') && to == undo.epSquare) {
+        pos.board[toRow][toCol] = ' ';
+        pos.board[fromRow][toCol] = undo.capturedPiece;
+    } else {
+        pos.board[toRow][toCol] = undo.capturedPiece;
+    }
+    
+    if ((piece == 'K' || piece == 'k') && (toCol - fromCol == 2 || fromCol - toCol == 2)) {
+        int rookFrom = toCol > fromCol ? 7 : 0;
+        int rookTo = toCol > fromCol ? 5 : 3;
+        pos.board[fromRow][rookFrom] = pos.board[fromRow][rookTo];
+        pos.board[fromRow][rookTo] = ' ';
+    }
+    
+    pos.whiteToMove = !pos.whiteToMove;
+    if (!pos.whiteToMove) pos.fullmoveNumber--;
+    pos.castling = undo.castling;
+    pos.epSquare = undo.epSquare;
+    pos.halfmoveClock = undo.halfmoveClock;
+    pos.hash = undo.hash;
+}
+
+// Check whether any piece of the given color ('w' or 'b') attacks a square
+bool ChessEngine::isSquareAttacked(const char board[8][8], int row, int col, char byColor) const {
+    bool byWhite = (byColor == 'w');
+    
+    // Pawns attack diagonally forward, so look one row behind the square
+    int pawnRow = row + (byWhite ? -1 : 1);
+    char pawn = byWhite ? 'P' : 'p';
+    for (int dc = -1; dc <= 1; dc += 2) {
+        if (isValidSquare(pawnRow, col + dc) && board[pawnRow][col + dc] == pawn) return true;
+    }
+    
+    // Knights and king
+    char knight = byWhite ? 'N' : 'n';
+    char king = byWhite ? 'K' : 'k';
+    for (int i = 0; i < 8; i++) {
+        int r = row + KNIGHT_STEPS[i][0], c = col + KNIGHT_STEPS[i][1];
+        if (isValidSquare(r, c) && board[r][c] == knight) return true;
+        r = row + KING_STEPS[i][0];
+        c = col + KING_STEPS[i][1];
+        if (isValidSquare(r, c) && board[r][c] == king) return true;
+    }
+    
+    // Sliders: the first piece along each ray decides (first four rays are straight)
+    char rook = byWhite ? 'R' : 'r';
+    char bishop = byWhite ? 'B' : 'b';
+    char queen = byWhite ? 'Q' : 'q';
+    for (int d = 0; d < 8; d++) {
+        char slider = (d < 4) ? rook : bishop;
+        for (int step = 1; step < 8; step++) {
+            int r = row + step * KING_STEPS[d][0];
+            int c = col + step * KING_STEPS[d][1];
+            if (!isValidSquare(r, c)) break;
+            char piece = board[r][c];
+            if (piece == ' ') continue;
+            if (piece == slider || piece == queen) return true;
+            break;
+        }
+    }
+    return false;
+}
+
+bool ChessEngine::isInCheck(const Position &pos, bool white) const {
+    char king = white ? 'K' : 'k';
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            if (pos.board[row][col] == king) {
+                return isSquareAttacked(pos.board, row, col, white ? 'b' : 'w');
+            }
+        }
+    }
+    return false;
 }
\ No newline at end of file
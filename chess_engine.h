@@ -1,41 +1,87 @@
 #ifndef CHESS_ENGINE_H
 #define CHESS_ENGINE_H
 
+#include <stdint.h>
+#include "chess_position.h"
+
 // ---------------------------
 // Chess Engine Class
 // ---------------------------
+// Rules only: every method is const and the engine holds no state, so one
+// instance can serve any number of games and threads at once. Per-game
+// state lives in GameContext (chess_context.h), per-search scratch in
+// ChessSearch.
 class ChessEngine {
 private:
     // Helper functions for move generation
-    void addPawnMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]);
-    void addRookMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]);
-    void addKnightMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]);
-    void addBishopMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]);
-    void addQueenMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]);
-    void addKingMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]);
-    
-    bool isSquareOccupiedByOpponent(const char board[8][8], int row, int col, char pieceColor);
-    bool isSquareEmpty(const char board[8][8], int row, int col);
-    bool isValidSquare(int row, int col);
-    char getPieceColor(char piece);
+    void addPawnMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const;
+    void addRookMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const;
+    void addKnightMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const;
+    void addBishopMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const;
+    void addQueenMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const;
+    void addKingMoves(const char board[8][8], int row, int col, char pieceColor, int &moveCount, int moves[][2]) const;
+    
+    void addSpecialMoves(const Position &pos, int row, int col, int &moveCount, int moves[][2]) const;
+    
+    bool isSquareOccupiedByOpponent(const char board[8][8], int row, int col, char pieceColor) const;
+    bool isSquareEmpty(const char board[8][8], int row, int col) const;
+    bool isValidSquare(int row, int col) const;
+    char getPieceColor(char piece) const;
 
 public:
     ChessEngine();
     
-    // Main move generation function
-    void getPossibleMoves(const char board[8][8], int row, int col, int &moveCount, int moves[][2]);
+    // Main move generation function. The Position overload adds castling
+    // and en passant, which need more than the board to decide.
+    void getPossibleMoves(const char board[8][8], int row, int col, int &moveCount, int moves[][2]) const;
+    void getPossibleMoves(const Position &pos, int row, int col, int &moveCount, int moves[][2]) const;
     
     // Move validation
-    bool isValidMove(const char board[8][8], int fromRow, int fromCol, int toRow, int toCol);
+    bool isValidMove(const char board[8][8], int fromRow, int fromCol, int toRow, int toCol) const;
     
     // Game state checks
-    bool isPawnPromotion(char piece, int targetRow);
-    char getPromotedPiece(char piece);
+    bool isPawnPromotion(char piece, int targetRow) const;
+    char getPromotedPiece(char piece) const;
     
     // Utility functions
-    void printMove(int fromRow, int fromCol, int toRow, int toCol);
-    char algebraicToCol(char file);
-    int algebraicToRow(int rank);
+    void printMove(int fromRow, int fromCol, int toRow, int toCol) const;
+    char algebraicToCol(char file) const;
+    int algebraicToRow(int rank) const;
+    
+    // Position hashing (Zobrist)
+    uint64_t hashPiece(char piece, int row, int col) const;
+    uint64_t hashSideToMove() const;
+    uint64_t hashCastling(uint8_t rights) const;
+    uint64_t hashEnPassant(int square) const;
+    uint64_t computeHash(const char board[8][8], bool whiteToMove) const;
+    uint64_t computeHash(const Position &pos) const;
+    
+    // Search support: encoded moves applied to a Position in place.
+    // setupPosition only has a board, so it grants the castling rights the
+    // placement still allows and starts the counters afresh.
+    static uint8_t castlingRightsFor(const char board[8][8]);
+    void setupPosition(Position &pos, const char board[8][8], bool whiteToMove) const;
+    bool setupPositionFromFEN(Position &pos, const char* fen) const;
+    int formatFEN(const Position &pos, char* fen) const;     // fen needs FEN_MAX_LENGTH
+    int generateMoves(const Position &pos, Move moves[]) const;
+    int generateLegalMoves(Position &pos, Move moves[]) const;
+    bool isLegalMove(Position &pos, Move move) const;
+    void makeMove(Position &pos, Move move, MoveUndo &undo) const;
+    void unmakeMove(Position &pos, Move move, const MoveUndo &undo) const;
+    
+    // Compact binary positions (PackedPosition). Packing a bare board stores
+    // no castling rights. Unpacking returns false for data that cannot be a
+    // board, e.g. from a corrupt transfer.
+    static void packPosition(const char board[8][8], bool whiteToMove, PackedPosition &packed);
+    static void packPosition(const Position &pos, PackedPosition &packed);
+    static bool unpackBoard(const PackedPosition &packed, char board[8][8], bool &whiteToMove);
+    bool unpackPosition(const PackedPosition &packed, Position &pos) const;
+    static void packedToHex(const PackedPosition &packed, char* hex);    // hex needs PACKED_HEX_LENGTH + 1
+    static bool packedFromHex(const char* hex, PackedPosition &packed);
+    
+    // Attack detection
+    bool isSquareAttacked(const char board[8][8], int row, int col, char byColor) const;
+    bool isInCheck(const Position &pos, bool white) const;
 };
 
 #endif // CHESS_ENGINE_H
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "chess_eval.h"
+#include "eval_weights.h"
+#include <string.h>
+
+// ---------------------------
+// ChessEval Implementation
+// ---------------------------
+
+// Contribution of each piece type (P N B R Q K) to the game phase
+static const int PHASE_WEIGHT[6] = {0, 1, 1, 2, 4, 0};
+
+ChessEval::ChessEval(const ChessEngine* ce) : engine(ce) {
+}
+
+// count is White's features minus Black's for the term
+void ChessEval::addTerm(int term, int count, int &mg, int &eg, EvalTrace* trace) const {
+    if (count == 0) return;
+    mg += count * EVAL_WEIGHTS[term][0];
+    eg += count * EVAL_WEIGHTS[term][1];
+    if (trace) trace->coefficients[term] += count;
+}
+
+int ChessEval::evaluate(const Position &pos, EvalTrace* trace) const {
+    int mg = 0;
+    int eg = 0;
+    int phase = 0;
+    int bishops[2] = {0, 0};
+    int pawnsOnFile[2][8];
+    memset(pawnsOnFile, 0, sizeof(pawnsOnFile));
+    if (trace) memset(trace, 0, sizeof(EvalTrace));
+
+    int moves[28][2];
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            char piece = pos.board[row][col];
+            if (piece == ' ') continue;
+
+            bool white = piece < 'a';
+            int side = white ? 0 : 1;
+            int sign = white ? 1 : -1;
+            int type = pieceIndex(piece) % 6;
+            int square = white ? row * 8 + col : (7 - row) * 8 + col;
+
+            addTerm(EVAL_MATERIAL + type, sign, mg, eg, trace);
+            addTerm(EVAL_PST + type * 64 + square, sign, mg, eg, trace);
+            phase += PHASE_WEIGHT[type];
+
+            if (type == 0) {
+                pawnsOnFile[side][col]++;
+            } else if (type >= 1 && type <= 4) {
+                int moveCount = 0;
+                engine->getPossibleMoves(pos.board, row, col, moveCount, moves);
+                addTerm(EVAL_MOBILITY + type - 1, sign * moveCount, mg, eg, trace);
+                if (type == 2) bishops[side]++;
+            }
+        }
+    }
+
+    addTerm(EVAL_BISHOP_PAIR, (bishops[0] >= 2) - (bishops[1] >= 2), mg, eg, trace);
+
+    // Pawn structure
+    for (int side = 0; side < 2; side++) {
+        int sign = side == 0 ? 1 : -1;
+        char pawn = side == 0 ? 'P' : 'p';
+        char enemyPawn = side == 0 ? 'p' : 'P';
+        int forward = side == 0 ? 1 : -1;
+
+        for (int col = 0; col < 8; col++) {
+            int count = pawnsOnFile[side][col];
+            if (count == 0) continue;
+            if (count > 1) addTerm(EVAL_DOUBLED_PAWN, sign * (count - 1), mg, eg, trace);
+
+            bool leftFile = col > 0 && pawnsOnFile[side][col - 1] > 0;
+            bool rightFile = col < 7 && pawnsOnFile[side][col + 1] > 0;
+            if (!leftFile && !rightFile) addTerm(EVAL_ISOLATED_PAWN, sign * count, mg, eg, trace);
+
+            for (int row = 1; row < 7; row++) {
+                if (pos.board[row][col] != pawn) continue;
+
+                // Passed if no enemy pawn can block or capture it on its way
+                bool passed = true;
+                for (int r = row + forward; r >= 0 && r < 8 && passed; r += forward) {
+                    for (int c = col - 1; c <= col + 1; c++) {
+                        if (c >= 0 && c < 8 && pos.board[r][c] == enemyPawn) passed = false;
+                    }
+                }
+                if (passed) {
+                    int rank = side == 0 ? row : 7 - row;
+                    addTerm(EVAL_PASSED_PAWN + rank, sign, mg, eg, trace);
+                }
+            }
+        }
+    }
+
+    if (phase > EVAL_PHASE_MAX) phase = EVAL_PHASE_MAX;
+    if (trace) trace->phase = phase;
+
+    int score = (mg * phase + eg * (EVAL_PHASE_MAX - phase)) / EVAL_PHASE_MAX;
+    return pos.whiteToMove ? score : -score;
+}
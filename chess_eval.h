@@ -0,0 +1,50 @@
+#ifndef CHESS_EVAL_H
+#define CHESS_EVAL_H
+
+#include <stdint.h>
+#include "chess_engine.h"
+
+// ---------------------------
+// Evaluation Terms
+// ---------------------------
+// Indices into EVAL_WEIGHTS (eval_weights.h). Every term has a middlegame
+// and an endgame weight, blended by game phase. Square tables are indexed
+// row * 8 + col from the owner's side, so Black's squares are mirrored.
+enum EvalTerm {
+    EVAL_MATERIAL       = 0,                        // P N B R Q K
+    EVAL_PST            = EVAL_MATERIAL + 6,        // 6 pieces x 64 squares
+    EVAL_MOBILITY       = EVAL_PST + 6 * 64,        // Per reachable square: N B R Q
+    EVAL_BISHOP_PAIR    = EVAL_MOBILITY + 4,
+    EVAL_DOUBLED_PAWN   = EVAL_BISHOP_PAIR + 1,
+    EVAL_ISOLATED_PAWN  = EVAL_DOUBLED_PAWN + 1,
+    EVAL_PASSED_PAWN    = EVAL_ISOLATED_PAWN + 1,   // By relative rank 0-7
+    EVAL_TERM_COUNT     = EVAL_PASSED_PAWN + 8
+};
+
+#define EVAL_PHASE_MAX  24  // Phase of the full set of minor and major pieces
+
+// Per-term feature counts (White minus Black) of one evaluation. The score
+// is linear in the weights, which is what the Texel tuner fits.
+struct EvalTrace {
+    int16_t coefficients[EVAL_TERM_COUNT];
+    int phase;
+};
+
+// ---------------------------
+// Evaluation Class
+// ---------------------------
+class ChessEval {
+private:
+    const ChessEngine* engine;
+
+    void addTerm(int term, int count, int &mg, int &eg, EvalTrace* trace) const;
+
+public:
+    ChessEval(const ChessEngine* ce);
+
+    // Centipawns from the side to move's point of view. When a trace is
+    // given it receives the feature counts behind the score.
+    int evaluate(const Position &pos, EvalTrace* trace = 0) const;
+};
+
+#endif // CHESS_EVAL_H
@@ -0,0 +1,61 @@
+#include "chess_history.h"
+
+// ---------------------------
+// ChessHistory Implementation
+// ---------------------------
+
+ChessHistory::ChessHistory() {
+    reset(0);
+}
+
+void ChessHistory::reset(uint64_t startHash, int startHalfmoveClock) {
+    hashes[0] = startHash;
+    count = 1;
+    halfmoveClock = startHalfmoveClock;
+}
+
+void ChessHistory::push(uint64_t hash, bool irreversible) {
+    hashes[count & (HISTORY_SIZE - 1)] = hash;
+    count++;
+    halfmoveClock = irreversible ? 0 : halfmoveClock + 1;
+}
+
+void ChessHistory::pop(int previousHalfmoveClock) {
+    if (count > 1) count--;
+    halfmoveClock = previousHalfmoveClock;
+}
+
+uint64_t ChessHistory::currentHash() {
+    return hashes[(count - 1) & (HISTORY_SIZE - 1)];
+}
+
+// Number of earlier occurrences of the current position. Only positions with
+// the same side to move (every second ply) since the last irreversible move
+// can match, and never more than the ring still holds.
+int ChessHistory::repetitionCount() {
+    int limit = halfmoveClock;
+    if (limit > count - 1) limit = count - 1;
+    if (limit > HISTORY_SIZE - 1) limit = HISTORY_SIZE - 1;
+    
+    uint64_t current = currentHash();
+    int repetitions = 0;
+    for (int back = 2; back <= limit; back += 2) {
+        if (hashes[(count - 1 - back) & (HISTORY_SIZE - 1)] == current) {
+            repetitions++;
+        }
+    }
+    return repetitions;
+}
+
+// A single repetition is enough for a search to score the line as a draw
+bool ChessHistory::isRepetition() {
+    return repetitionCount() >= 1;
+}
+
+bool ChessHistory::isThreefoldRepetition() {
+    return repetitionCount() >= 2;
+}
+
+bool ChessHistory::isFiftyMoveDraw() {
+    return halfmoveClock >= FIFTY_MOVE_PLIES;
+}
@@ -0,0 +1,42 @@
+#ifndef CHESS_HISTORY_H
+#define CHESS_HISTORY_H
+
+#include <stdint.h>
+
+// Ring size must be a power of two and cover the fifty-move window
+#define HISTORY_SIZE        128
+#define FIFTY_MOVE_PLIES    100
+
+// ---------------------------
+// Game History Class
+// ---------------------------
+// Fixed-size ring of position hashes plus the halfmove clock. Repetition
+// checks only scan back to the last irreversible move (pawn move or capture),
+// since no position before it can occur again.
+class ChessHistory {
+private:
+    uint64_t hashes[HISTORY_SIZE];
+    int count;          // Positions pushed since reset (ring index = count & mask)
+    int halfmoveClock;  // Plies since the last pawn move or capture
+
+public:
+    ChessHistory();
+    
+    // Start a new game (or edited position) from the given hash
+    void reset(uint64_t startHash, int startHalfmoveClock = 0);
+    
+    // Record the position reached after a move, and take it back again
+    void push(uint64_t hash, bool irreversible);
+    void pop(int previousHalfmoveClock);
+    
+    // Draw detection
+    int repetitionCount();
+    bool isRepetition();
+    bool isThreefoldRepetition();
+    bool isFiftyMoveDraw();
+    
+    uint64_t currentHash();
+    int getHalfmoveClock() { return halfmoveClock; }
+};
+
+#endif // CHESS_HISTORY_H
@@ -0,0 +1,154 @@
+#include "chess_mate.h"
+
+// ---------------------------
+// MateSolver Implementation
+// ---------------------------
+
+MateSolver::MateSolver(const ChessEngine* ce) : engine(ce) {
+    nodes = 0;
+    nodeLimit = 0;
+    aborted = false;
+    moveStackTop = 0;
+}
+
+Move MateSolver::solve(const Position &start, int maxMoves, int &mateIn, uint32_t limit) {
+    pos = start;
+    nodes = 0;
+    nodeLimit = limit;
+    aborted = false;
+    moveStackTop = 0;
+    mateIn = 0;
+
+    Move moves[MAX_MOVES];
+    for (int n = 1; n <= maxMoves && n <= MATE_MAX_MOVES; n++) {
+        // A mating move is always a check, so only longer mates may start quietly
+        int count = generateAttackerMoves(moves, n > 1);
+        for (int i = 0; i < count && !aborted; i++) {
+            MoveUndo undo;
+            engine->makeMove(pos, moves[i], undo);
+            bool mates = defenderLoses(n);
+            engine->unmakeMove(pos, moves[i], undo);
+            if (mates && !aborted) {
+                mateIn = n;
+                return moves[i];
+            }
+        }
+        if (aborted) break;
+    }
+    return MOVE_NONE;
+}
+
+bool MateSolver::isMatingMove(const Position &start, Move move, int movesLeft, uint32_t limit) {
+    pos = start;
+    nodes = 0;
+    nodeLimit = limit;
+    aborted = false;
+    moveStackTop = 0;
+    if (movesLeft < 1 || movesLeft > MATE_MAX_MOVES || !engine->isLegalMove(pos, move)) return false;
+
+    MoveUndo undo;
+    engine->makeMove(pos, move, undo);
+    return defenderLoses(movesLeft) && !aborted;
+}
+
+Move MateSolver::bestDefence(const Position &start, int movesLeft, uint32_t limit) {
+    pos = start;
+    nodes = 0;
+    nodeLimit = limit;
+    aborted = false;
+    moveStackTop = 0;
+
+    Move moves[MAX_MOVES];
+    int count = engine->generateLegalMoves(pos, moves);
+    if (count == 0) return MOVE_NONE;
+
+    // Replies are ranked by the shortest mate the attacker still has after them
+    Move best = moves[0];
+    int longest = 0;
+    for (int i = 0; i < count && !aborted; i++) {
+        MoveUndo undo;
+        engine->makeMove(pos, moves[i], undo);
+        int mateIn = 0;
+        for (int n = 1; n <= movesLeft && n <= MATE_MAX_MOVES && mateIn == 0 && !aborted; n++) {
+            if (attackerWins(n)) mateIn = n;
+        }
+        engine->unmakeMove(pos, moves[i], undo);
+        if (aborted) break;
+        if (mateIn == 0) return moves[i];   // Escapes
+        if (mateIn > longest) {
+            longest = mateIn;
+            best = moves[i];
+        }
+    }
+    return best;
+}
+
+// Whether the side to move can force mate within movesLeft moves
+bool MateSolver::attackerWins(int movesLeft) {
+    if (countNode()) return false;
+    if (moveStackTop + MAX_MOVES > MATE_MOVE_STACK) {
+        aborted = true;
+        return false;
+    }
+
+    Move* moves = moveStack + moveStackTop;
+    int count = generateAttackerMoves(moves, false);
+    moveStackTop += count;
+    bool wins = false;
+    for (int i = 0; i < count && !wins && !aborted; i++) {
+        MoveUndo undo;
+        engine->makeMove(pos, moves[i], undo);
+        wins = defenderLoses(movesLeft);
+        engine->unmakeMove(pos, moves[i], undo);
+    }
+    moveStackTop -= count;
+    return wins && !aborted;
+}
+
+// Whether the side to move, just after an attacker move, is mated now or
+// after every reply within the attacker's remaining moves
+bool MateSolver::defenderLoses(int movesLeft) {
+    if (countNode()) return false;
+    if (moveStackTop + MAX_MOVES > MATE_MOVE_STACK) {
+        aborted = true;
+        return false;
+    }
+
+    Move* moves = moveStack + moveStackTop;
+    int count = engine->generateLegalMoves(pos, moves);
+    if (count == 0) return engine->isInCheck(pos, pos.whiteToMove);   // Mate, not stalemate
+    if (movesLeft <= 1) return false;
+
+    moveStackTop += count;
+    bool loses = true;
+    for (int i = 0; i < count && loses && !aborted; i++) {
+        MoveUndo undo;
+        engine->makeMove(pos, moves[i], undo);
+        loses = attackerWins(movesLeft - 1);
+        engine->unmakeMove(pos, moves[i], undo);
+    }
+    moveStackTop -= count;
+    return loses && !aborted;
+}
+
+// Legal moves for the attacker: only checks unless quiet moves are allowed
+int MateSolver::generateAttackerMoves(Move moves[], bool quietAllowed) {
+    int count = engine->generateMoves(pos, moves);
+    bool white = pos.whiteToMove;
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        MoveUndo undo;
+        engine->makeMove(pos, moves[i], undo);
+        if (!engine->isInCheck(pos, white) && (quietAllowed || engine->isInCheck(pos, !white))) {
+            moves[kept++] = moves[i];
+        }
+        engine->unmakeMove(pos, moves[i], undo);
+    }
+    return kept;
+}
+
+bool MateSolver::countNode() {
+    nodes++;
+    if (nodeLimit != 0 && nodes >= nodeLimit) aborted = true;
+    return aborted;
+}
@@ -0,0 +1,58 @@
+#ifndef CHESS_MATE_H
+#define CHESS_MATE_H
+
+#include "chess_engine.h"
+
+// ---------------------------
+// Mate Solver Configuration
+// ---------------------------
+#define MATE_MAX_MOVES      4       // Longest mate searched for, in attacker moves
+#define MATE_MOVE_STACK     1536    // Shared by all plies; a node needs at most MAX_MOVES
+
+// ---------------------------
+// Mate Solver Class
+// ---------------------------
+// Dedicated AND/OR search for forced mates, separate from ChessSearch: no
+// evaluation, no time control, just "can the attacker force mate within n
+// moves". Below the first move the attacker only tries checking moves,
+// which keeps the tree narrow enough for the board and still finds every
+// mate whose later moves are all checks; the first move may be quiet.
+// Searching n = 1, 2, ... returns the shortest mate.
+class MateSolver {
+private:
+    const ChessEngine* engine;
+    Position pos;
+    uint32_t nodes;
+    uint32_t nodeLimit;
+    bool aborted;
+
+    // Move lists of all plies live in one buffer, as in ChessSearch
+    Move moveStack[MATE_MOVE_STACK];
+    int moveStackTop;
+
+    bool attackerWins(int movesLeft);
+    bool defenderLoses(int movesLeft);
+    int generateAttackerMoves(Move moves[], bool quietAllowed);
+    bool countNode();
+
+public:
+    MateSolver(const ChessEngine* ce);
+
+    // Shortest forced mate of at most maxMoves moves for the side to move.
+    // Returns its first move and sets mateIn, or MOVE_NONE if there is none
+    // (or nodeLimit, if non-zero, ran out first).
+    Move solve(const Position &start, int maxMoves, int &mateIn, uint32_t nodeLimit = 0);
+
+    // Whether move still forces mate within movesLeft moves counting itself;
+    // used to accept alternative solutions in puzzles
+    bool isMatingMove(const Position &start, Move move, int movesLeft, uint32_t nodeLimit = 0);
+
+    // The defender's most stubborn reply: one that escapes mate within
+    // movesLeft attacker moves if possible, else the one that delays it most
+    Move bestDefence(const Position &start, int movesLeft, uint32_t nodeLimit = 0);
+
+    uint32_t getNodes() { return nodes; }
+    bool wasAborted() { return aborted; }   // Last call ran out of nodes
+};
+
+#endif // CHESS_MATE_H
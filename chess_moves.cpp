@@ -14,22 +14,35 @@ const char ChessMoves::INITIAL_BOARD[8][8] = {
   {'r', 'n', 'b', 'k', 'q', 'b', 'n', 'r'}     // row 7 (rank 1 - white pieces at bottom)
 };
 
-ChessMoves::ChessMoves(BoardDriver* bd, ChessEngine* ce) : boardDriver(bd), chessEngine(ce) {
+ChessMoves::ChessMoves(BoardDriver* bd, ChessEngine* ce, ChessSearch* cs)
+    : boardDriver(bd), chessEngine(ce), chessSearch(cs), blunderCheck(ce, cs), steps(bd) {
+    threatOverlay = OVERLAY_HANGING;
+    blunderWarnings = false;
+    selectedSquare = captureSquare = promotionSquare = -1;
+    selectedTargets = 0;
+    
     // Initialize board state
     initializeBoard();
+    resetHistory();
 }
 
 void ChessMoves::begin() {
     Serial.println("Starting Chess Game Mode...");
+    boardDriver->clearOverlay();
+    steps.cancel();
+    promotionSquare = -1;
+    clearSelection();
     
     // Copy expected configuration into our board state
     initializeBoard();
+    resetHistory();
 
     // Wait for board setup
     waitForBoardSetup();
     
     Serial.println("Chess game ready to start!");
     boardDriver->fireworkAnimation();
+    showThreats();
 
     // Initialize sensor previous state for move detection
     boardDriver->readSensors();
@@ -37,197 +50,144 @@ void ChessMoves::begin() {
 }
 
 void ChessMoves::update() {
-    boardDriver->readSensors();
-
-    // Look for a piece pickup
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            if (boardDriver->getSensorPrev(row, col) && !boardDriver->getSensorState(row, col)) {
-                char piece = board[row][col];
-                
-                // Skip empty squares
-                if (piece == ' ') continue;
-                
-                Serial.print("Piece lifted from ");
+    // The board catches up with the last move before the next one starts
+    if (steps.pending()) {
+        if (steps.follow() && promotionSquare >= 0) {
+            Serial.println("Queen placed, promotion complete");
+            boardDriver->flashSquares(1ULL << promotionSquare, BoardDriver::color(255, 215, 0, 50), 3, 200);
+            promotionSquare = -1;
+        }
+        boardDriver->updateSensorPrev();
+        return;
+    }
+    
+    // Lifts from the scanner select a piece; a placement on one of its legal
+    // targets plays it. A capture starts with the target piece being lifted
+    // and ends when the capturing piece is placed on that square.
+    SensorEvent event;
+    while (boardDriver->pollEvent(event)) {
+        int row = event.square >> 3;
+        int col = event.square & 7;
+        
+        if (selectedSquare < 0) {
+            if (event.type == SENSOR_LIFT) selectPiece(row, col);
+        } else if (captureSquare >= 0) {
+            if (event.type == SENSOR_PLACE && event.square == captureSquare) playMove(row, col);
+        } else if (event.type == SENSOR_PLACE && event.square == selectedSquare) {
+            Serial.println("Piece replaced in original spot");
+            // Clear all LED effects and blink once to confirm
+            clearSelection();
+            boardDriver->flashSquares(1ULL << event.square, BoardDriver::color(0, 0, 0, 255), 1, 400);
+        } else if ((selectedTargets >> event.square) & 1) {
+            bool occupied = pos.board[row][col] != ' ';
+            if (occupied && event.type == SENSOR_LIFT) {
+                Serial.print("Capture initiated at ");
                 Serial.print((char)('a' + col));
                 Serial.println(row + 1);
+                captureSquare = event.square;
                 
-                // Generate possible moves
-                int moveCount = 0;
-                int moves[28][2]; // up to 28 moves (maximum for a queen)
-                chessEngine->getPossibleMoves(board, row, col, moveCount, moves);
-                
-                // Light up current square and possible move squares
-                boardDriver->setSquareLED(row, col, 0, 0, 0, 100); // Dimmer, but solid
-                
-                // Highlight possible move squares (including captures)
-                for (int i = 0; i < moveCount; i++) {
-                    int r = moves[i][0];
-                    int c = moves[i][1];
-                    
-                    // Different highlighting for empty squares vs capture squares
-                    if (board[r][c] == ' ') {
-                        boardDriver->setSquareLED(r, c, 0, 0, 0, 50); // Soft white for moves
-                    } else {
-                        boardDriver->setSquareLED(r, c, 255, 0, 0, 50); // Red tint for captures
-                    }
-                }
+                // Light the capture square to show where the piece goes
+                boardDriver->setSquareLED(row, col, 255, 0, 0, 100);
                 boardDriver->showLEDs();
-                
-                // Wait for piece placement - handle both normal moves and captures
-                int targetRow = -1, targetCol = -1;
-                bool piecePlaced = false;
-                bool captureInProgress = false;
-
-                // Wait for a piece placement on any square
-                while (!piecePlaced) {
-                    boardDriver->readSensors();
-                    
-                    // First check if the original piece was placed back
-                    if (boardDriver->getSensorState(row, col)) {
-                        targetRow = row;
-                        targetCol = col;
-                        piecePlaced = true;
-                        break;
-                    }
-                    
-                    // Then check all squares for a regular move or capture initiation
-                    for (int r2 = 0; r2 < 8; r2++) {
-                        for (int c2 = 0; c2 < 8; c2++) {
-                            // Skip the original square which was already checked
-                            if (r2 == row && c2 == col) continue;
-                            
-                            // Check if this would be a legal move
-                            bool isLegalMove = false;
-                            for (int i = 0; i < moveCount; i++) {
-                                if (moves[i][0] == r2 && moves[i][1] == c2) {
-                                    isLegalMove = true;
-                                    break;
-                                }
-                            }
-                            
-                            // If not a legal move, no need to check further
-                            if (!isLegalMove) continue;
-                            
-                            // For capture moves: detect when the target piece is removed
-                            if (board[r2][c2] != ' ' && !boardDriver->getSensorState(r2, c2) && boardDriver->getSensorPrev(r2, c2)) {
-                                Serial.print("Capture initiated at ");
-                                Serial.print((char)('a' + c2));
-                                Serial.println(r2 + 1);
-                                
-                                // Store the target square and wait for the capturing piece to be placed there
-                                targetRow = r2;
-                                targetCol = c2;
-                                captureInProgress = true;
-                                
-                                // Flash the capture square to indicate waiting for piece placement
-                                boardDriver->setSquareLED(r2, c2, 255, 0, 0, 100);
-                                boardDriver->showLEDs();
-                                
-                                // Wait for the capturing piece to be placed
-                                bool capturePiecePlaced = false;
-                                while (!capturePiecePlaced) {
-                                    boardDriver->readSensors();
-                                    if (boardDriver->getSensorState(r2, c2)) {
-                                        capturePiecePlaced = true;
-                                        piecePlaced = true;
-                                        break;
-                                    }
-                                    delay(50);
-                                }
-                                break;
-                            }
-                            
-                            // For normal non-capture moves: detect when a piece is placed on an empty square
-                            else if (board[r2][c2] == ' ' && boardDriver->getSensorState(r2, c2) && !boardDriver->getSensorPrev(r2, c2)) {
-                                targetRow = r2;
-                                targetCol = c2;
-                                piecePlaced = true;
-                                break;
-                            }
-                        }
-                        if (piecePlaced || captureInProgress) break;
-                    }
-                    
-                    delay(50);
-                }
-
-                // Check if piece is replaced in the original spot
-                if (targetRow == row && targetCol == col) {
-                    Serial.println("Piece replaced in original spot");
-                    // Blink once to confirm
-                    boardDriver->setSquareLED(row, col, 0, 0, 0, 255);
-                    boardDriver->showLEDs();
-                    delay(200);
-                    boardDriver->setSquareLED(row, col, 0, 0, 0, 100);
-                    boardDriver->showLEDs();
-                    
-                    // Clear all LED effects
-                    boardDriver->clearAllLEDs();
-                    
-                    continue; // Skip to next iteration
-                }
-                
-                // Check if move is legal
-                bool legalMove = false;
-                bool isCapture = false;
-                for (int i = 0; i < moveCount; i++) {
-                    if (moves[i][0] == targetRow && moves[i][1] == targetCol) {
-                        legalMove = true;
-                        // Check if this is a capture move
-                        if (board[targetRow][targetCol] != ' ') {
-                            isCapture = true;
-                        }
-                        break;
-                    }
-                }
-                
-                if (legalMove) {
-                    Serial.print("Legal move to ");
-                    Serial.print((char)('a' + targetCol));
-                    Serial.println(targetRow + 1);
-                    
-                    // Play capture animation if needed
-                    if (board[targetRow][targetCol] != ' ') {
-                        Serial.println("Performing capture animation");
-                        boardDriver->captureAnimation();
-                    }
-                    
-                    // Process the move
-                    processMove(row, col, targetRow, targetCol, piece);
-                    
-                    // Check for pawn promotion
-                    checkForPromotion(targetRow, targetCol, piece);
-                    
-                    // Confirmation: Double blink destination square
-                    for (int blink = 0; blink < 2; blink++) {
-                        boardDriver->setSquareLED(targetRow, targetCol, 0, 0, 0, 255);
-                        boardDriver->showLEDs();
-                        delay(200);
-                        boardDriver->setSquareLED(targetRow, targetCol, 0, 0, 0, 50);
-                        boardDriver->showLEDs();
-                        delay(200);
-                    }
-                } else {
-                    Serial.println("Illegal move, reverting");
-                }
-                
-                // Clear any remaining LED effects
-                boardDriver->clearAllLEDs();
+            } else if (!occupied && event.type == SENSOR_PLACE) {
+                playMove(row, col);
             }
         }
     }
     
-    // Update previous sensor state
+    // Scan at full rate while a piece is in hand
+    boardDriver->setScanHold(selectedSquare >= 0);
     boardDriver->updateSensorPrev();
 }
 
-void ChessMoves::initializeBoard() {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            board[row][col] = INITIAL_BOARD[row][col];
+void ChessMoves::selectPiece(int row, int col) {
+    // Skip empty squares
+    if (pos.board[row][col] == ' ') return;
+    
+    Serial.print("Piece lifted from ");
+    Serial.print((char)('a' + col));
+    Serial.println(row + 1);
+    
+    // Generate possible moves
+    int moveCount = 0;
+    int moves[28][2]; // up to 28 moves (maximum for a queen)
+    chessEngine->getPossibleMoves(pos, row, col, moveCount, moves);
+    
+    // Light up current square and possible move squares
+    boardDriver->setSquareLED(row, col, 0, 0, 0, 100); // Dimmer, but solid
+    
+    // Highlight possible move squares (including captures)
+    selectedTargets = 0;
+    for (int i = 0; i < moveCount; i++) {
+        int r = moves[i][0];
+        int c = moves[i][1];
+        selectedTargets |= 1ULL << (r * 8 + c);
+        
+        // Different highlighting for empty squares vs capture squares
+        if (pos.board[r][c] == ' ') {
+            boardDriver->setSquareLED(r, c, 0, 0, 0, 50); // Soft white for moves
+        } else {
+            boardDriver->setSquareLED(r, c, 255, 0, 0, 50); // Red tint for captures
         }
     }
+    boardDriver->showLEDs();
+    selectedSquare = row * 8 + col;
+}
+
+// Only legal targets reach here, so the move is always played
+void ChessMoves::playMove(int targetRow, int targetCol) {
+    int row = selectedSquare >> 3;
+    int col = selectedSquare & 7;
+    char piece = pos.board[row][col];
+    
+    Serial.print("Legal move to ");
+    Serial.print((char)('a' + targetCol));
+    Serial.println(targetRow + 1);
+    handTurnTo(piece >= 'A' && piece <= 'Z');
+    
+    // Judge the move while the board still holds the position before it;
+    // the search budget is small enough not to hold up the confirmation
+    BlunderReport blunder;
+    bool blundered = false;
+    if (blunderWarnings) {
+        int promotion = chessEngine->isPawnPromotion(piece, targetRow) ? PROMOTE_QUEEN : PROMOTE_NONE;
+        Move played = encodeMove(row * 8 + col, targetRow * 8 + targetCol, promotion);
+        blunder = blunderCheck.check(pos, history, played);
+        blundered = BlunderCheck::isBlunder(blunder);
+    }
+    
+    // Process the move
+    clearSelection();
+    MoveUndo undo;
+    processMove(row, col, targetRow, targetCol, piece, undo);
+    
+    // Play capture animation if needed
+    if (undo.capturedPiece != ' ') {
+        Serial.println("Performing capture animation");
+        boardDriver->captureAnimation();
+    }
+    
+    // Check for pawn promotion
+    checkForPromotion(targetRow, targetCol, piece);
+    
+    // Record the resulting position for draw detection
+    recordMove();
+    
+    // Confirmation: Double blink destination square
+    boardDriver->flashSquares(1ULL << (targetRow * 8 + targetCol), BoardDriver::color(0, 0, 0, 255), 2, 400);
+    if (blundered) warnBlunder(blunder);
+}
+
+void ChessMoves::clearSelection() {
+    selectedSquare = -1;
+    selectedTargets = 0;
+    captureSquare = -1;
+    boardDriver->clearAllLEDs();
+}
+
+// The kings start off the e-file in this layout, so there are no castling rights
+void ChessMoves::initializeBoard() {
+    chessEngine->setupPosition(pos, INITIAL_BOARD, true);
 }
 
 void ChessMoves::waitForBoardSetup() {
@@ -239,16 +199,27 @@ void ChessMoves::waitForBoardSetup() {
     }
 }
 
-void ChessMoves::processMove(int fromRow, int fromCol, int toRow, int toCol, char piece) {
-    // Update board state
-    board[toRow][toCol] = piece;
-    board[fromRow][fromCol] = ' ';
+// Turns are not enforced in this mode, so the side to move follows the piece
+void ChessMoves::handTurnTo(bool white) {
+    if (pos.whiteToMove == white) return;
+    pos.whiteToMove = white;
+    pos.epSquare = -1;
+    pos.hash = chessEngine->computeHash(pos);
+}
+
+void ChessMoves::processMove(int fromRow, int fromCol, int toRow, int toCol, char piece, MoveUndo &undo) {
+    // Update board state; a pawn reaching the last rank becomes a queen
+    int promotion = chessEngine->isPawnPromotion(piece, toRow) ? PROMOTE_QUEEN : PROMOTE_NONE;
+    Move move = encodeMove(fromRow * 8 + fromCol, toRow * 8 + toCol, promotion);
+    chessEngine->makeMove(pos, move, undo);
+    
+    // The player has moved the piece; the rook of a castling and the pawn
+    // taken en passant are walked through as steps
+    steps.addMove(move, undo, false);
 }
 
 void ChessMoves::checkForPromotion(int targetRow, int targetCol, char piece) {
     if (chessEngine->isPawnPromotion(piece, targetRow)) {
-        char promotedPiece = chessEngine->getPromotedPiece(piece);
-        
         Serial.print((piece == 'P' ? "White" : "Black"));
         Serial.print(" pawn promoted to Queen at ");
         Serial.print((char)('a' + targetCol));
@@ -257,84 +228,89 @@ void ChessMoves::checkForPromotion(int targetRow, int targetCol, char piece) {
         // Play promotion animation
         boardDriver->promotionAnimation(targetCol);
         
-        // Promote to queen in board state
-        board[targetRow][targetCol] = promotedPiece;
-        
-        // Handle the promotion process
-        handlePromotion(targetRow, targetCol, piece);
+        // Then the pawn is swapped for a queen, followed from update()
+        promotionSquare = targetRow * 8 + targetCol;
+        steps.add(promotionSquare, promotionSquare);
     }
 }
 
-void ChessMoves::handlePromotion(int targetRow, int targetCol, char piece) {
-    Serial.println("Please replace the pawn with a queen piece");
-    
-    // First wait for the pawn to be removed
-    while (boardDriver->getSensorState(targetRow, targetCol)) {
-        // Blink the square to indicate action needed
-        boardDriver->setSquareLED(targetRow, targetCol, 255, 215, 0, 50);
-        boardDriver->showLEDs();
-        delay(250);
-        boardDriver->setSquareLED(targetRow, targetCol, 0, 0, 0, 0);
-        boardDriver->showLEDs();
-        delay(250);
-        
-        // Read sensors
-        boardDriver->readSensors();
-    }
-    
-    Serial.println("Pawn removed, please place a queen");
+void ChessMoves::resetHistory() {
+    history.reset(pos.hash, pos.halfmoveClock);
+    attacks.reset(pos.board);
+}
+
+void ChessMoves::recordMove() {
+    history.push(pos.hash, pos.halfmoveClock == 0);
     
-    // Then wait for the queen to be placed
-    while (!boardDriver->getSensorState(targetRow, targetCol)) {
-        // Blink the square to indicate action needed
-        boardDriver->setSquareLED(targetRow, targetCol, 255, 215, 0, 50);
-        boardDriver->showLEDs();
-        delay(250);
-        boardDriver->setSquareLED(targetRow, targetCol, 0, 0, 0, 0);
-        boardDriver->showLEDs();
-        delay(250);
-        
-        // Read sensors
-        boardDriver->readSensors();
+    if (history.isThreefoldRepetition()) {
+        Serial.println("Draw available: threefold repetition");
+    } else if (history.isFiftyMoveDraw()) {
+        Serial.println("Draw available: fifty-move rule");
     }
     
-    Serial.println("Queen placed, promotion complete");
-    
-    // Final confirmation blink
-    for (int i = 0; i < 3; i++) {
-        boardDriver->setSquareLED(targetRow, targetCol, 255, 215, 0, 50);
-        boardDriver->showLEDs();
-        delay(100);
-        boardDriver->setSquareLED(targetRow, targetCol, 0, 0, 0, 0);
-        boardDriver->showLEDs();
-        delay(100);
+    attacks.update(pos.board);
+    showThreats();
+}
+
+// Paints the overlay for the side to move; the LEDs only change when it does
+void ChessMoves::showThreats() {
+    uint64_t squares = attacks.overlaySquares(threatOverlay, pos.whiteToMove);
+    if (threatOverlay == OVERLAY_HANGING) {
+        boardDriver->setOverlay(squares, 255, 0, 0);    // Red: piece en prise
+    } else {
+        boardDriver->setOverlay(squares, 40, 0, 0);     // Dim red: attacked square
     }
 }
 
+void ChessMoves::warnBlunder(const BlunderReport &report) {
+    Serial.print("Careful: that move gives away about ");
+    Serial.print(report.loss / 100.0, 1);
+    Serial.print(" pawns. Better was ");
+    Serial.print((char)('a' + (moveFrom(report.best) & 7)));
+    Serial.print((moveFrom(report.best) >> 3) + 1);
+    Serial.print((char)('a' + (moveTo(report.best) & 7)));
+    Serial.println((moveTo(report.best) >> 3) + 1);
+    boardDriver->warnSquare(report.square >> 3, report.square & 7);
+}
+
+// Takes effect from the next move, so it is safe to call outside a game
+void ChessMoves::setThreatOverlay(ThreatOverlay overlay) {
+    threatOverlay = overlay;
+}
+
 bool ChessMoves::isActive() {
     return true; // Simple implementation for now
 }
 
 void ChessMoves::reset() {
-    boardDriver->clearAllLEDs();
+    boardDriver->clearOverlay();
+    steps.cancel();
+    promotionSquare = -1;
+    clearSelection();
     initializeBoard();
+    resetHistory();
 }
 
 void ChessMoves::getBoardState(char boardState[8][8]) {
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
-            boardState[row][col] = board[row][col];
+            boardState[row][col] = pos.board[row][col];
         }
     }
 }
 
 void ChessMoves::setBoardState(char newBoardState[8][8]) {
     Serial.println("Board state updated via WiFi edit");
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            board[row][col] = newBoardState[row][col];
-        }
-    }
+    // An edited position starts a fresh history, with the castling rights
+    // its king and rook placement allows
+    chessEngine->setupPosition(pos, newBoardState, pos.whiteToMove);
+    steps.cancel();
+    promotionSquare = -1;
+    clearSelection();
+    history.reset(pos.hash, pos.halfmoveClock);
+    attacks.update(pos.board);
+    showThreats();
+    
     // Update sensor previous state to match new board
     boardDriver->readSensors();
     boardDriver->updateSensorPrev();
@@ -3,6 +3,10 @@
 
 #include "board_driver.h"
 #include "chess_engine.h"
+#include "chess_attacks.h"
+#include "chess_history.h"
+#include "chess_blunder.h"
+#include "board_steps.h"
 
 // ---------------------------
 // Chess Game Mode Class
@@ -11,29 +15,63 @@ class ChessMoves {
 private:
     BoardDriver* boardDriver;
     ChessEngine* chessEngine;
+    ChessSearch* chessSearch;
     
     // Expected initial configuration
     static const char INITIAL_BOARD[8][8];
     
-    // Internal board state for gameplay
-    char board[8][8];
+    // Internal game state: board, side to move, castling, en passant and clocks
+    Position pos;
+    
+    // Position hashes since the start of the game, for draw detection
+    ChessHistory history;
+    
+    // Attacked squares of both sides, updated on every move for the overlay
+    AttackMap attacks;
+    ThreatOverlay threatOverlay;
+    
+    // Optional check of each move against the best alternative (needs a search)
+    BlunderCheck blunderCheck;
+    bool blunderWarnings;
+    
+    // Changes the players still owe the board after a move: the rook of a
+    // castling, the pawn taken en passant, or the pawn swapped for a queen
+    // on the square in promotionSquare (-1 if none)
+    BoardSteps steps;
+    int promotionSquare;
+    
+    // Piece in hand (square index, -1 if none), its legal targets, and the
+    // target whose piece was lifted to make room for a capture (-1 if none)
+    int selectedSquare;
+    uint64_t selectedTargets;
+    int captureSquare;
     
     // Helper functions
     void initializeBoard();
+    void selectPiece(int row, int col);
+    void playMove(int targetRow, int targetCol);
+    void clearSelection();
     void waitForBoardSetup();
-    void processMove(int fromRow, int fromCol, int toRow, int toCol, char piece);
+    void handTurnTo(bool white);
+    void processMove(int fromRow, int fromCol, int toRow, int toCol, char piece, MoveUndo &undo);
     void checkForPromotion(int targetRow, int targetCol, char piece);
-    void handlePromotion(int targetRow, int targetCol, char piece);
+    void resetHistory();
+    void recordMove();
+    void showThreats();
+    void warnBlunder(const BlunderReport &report);
 
 public:
-    ChessMoves(BoardDriver* bd, ChessEngine* ce);
+    ChessMoves(BoardDriver* bd, ChessEngine* ce, ChessSearch* cs = 0);
     void begin();
     void update();
     bool isActive();
     void reset();
+    void setThreatOverlay(ThreatOverlay overlay);
+    void setBlunderWarnings(bool enabled) { blunderWarnings = enabled && chessSearch != 0; }
     
     // Get current board state for WiFi display
     void getBoardState(char boardState[8][8]);
+    bool isWhiteToMove() { return pos.whiteToMove; }
     
     // Set board state for editing/corrections
     void setBoardState(char newBoardState[8][8]);
@@ -0,0 +1,255 @@
+#include "chess_nnue.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSSE3__)
+  #include <tmmintrin.h>
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+#define NNUE_HEADER_SIZE    16
+#define NNUE_L1_SHIFT       6       // int32 layer sums are scaled back to int8 range
+#define NNUE_OUTPUT_SHIFT   12      // centipawns = output * outputScale >> 12
+
+// ---------------------------
+// Kernels
+// ---------------------------
+// Host builds pick AVX2 or SSE from the compiler flags (-mavx2, -mssse3);
+// the ESP32 and other boards use the portable scalar loops.
+
+// out = in + sum(add) - sum(sub) over n int16 lanes (n is a multiple of 32)
+static void accumulate(int16_t* out, const int16_t* in,
+                       const int16_t* const* add, int addCount,
+                       const int16_t* const* sub, int subCount, int n) {
+#if defined(__AVX2__)
+    for (int i = 0; i < n; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+        for (int a = 0; a < addCount; a++) {
+            v = _mm256_add_epi16(v, _mm256_loadu_si256((const __m256i*)(add[a] + i)));
+        }
+        for (int s = 0; s < subCount; s++) {
+            v = _mm256_sub_epi16(v, _mm256_loadu_si256((const __m256i*)(sub[s] + i)));
+        }
+        _mm256_storeu_si256((__m256i*)(out + i), v);
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        for (int a = 0; a < addCount; a++) {
+            v = _mm_add_epi16(v, _mm_loadu_si128((const __m128i*)(add[a] + i)));
+        }
+        for (int s = 0; s < subCount; s++) {
+            v = _mm_sub_epi16(v, _mm_loadu_si128((const __m128i*)(sub[s] + i)));
+        }
+        _mm_storeu_si128((__m128i*)(out + i), v);
+    }
+#else
+    for (int i = 0; i < n; i++) {
+        int32_t v = in[i];
+        for (int a = 0; a < addCount; a++) v += add[a][i];
+        for (int s = 0; s < subCount; s++) v -= sub[s][i];
+        out[i] = (int16_t)v;
+    }
+#endif
+}
+
+// Clamp int16 sums to [0, 127] and narrow them to bytes (n is a multiple of 32)
+static void clippedReLU(const int16_t* in, uint8_t* out, int n) {
+#if defined(__AVX2__)
+    const __m256i maxValue = _mm256_set1_epi8(127);
+    for (int i = 0; i < n; i += 32) {
+        __m256i packed = _mm256_packus_epi16(_mm256_loadu_si256((const __m256i*)(in + i)),
+                                             _mm256_loadu_si256((const __m256i*)(in + i + 16)));
+        // packus interleaves 128-bit lanes; restore input order
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_min_epu8(packed, maxValue));
+    }
+#elif defined(__SSE2__)
+    const __m128i maxValue = _mm_set1_epi8(127);
+    for (int i = 0; i < n; i += 16) {
+        __m128i packed = _mm_packus_epi16(_mm_loadu_si128((const __m128i*)(in + i)),
+                                          _mm_loadu_si128((const __m128i*)(in + i + 8)));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_min_epu8(packed, maxValue));
+    }
+#else
+    for (int i = 0; i < n; i++) {
+        int16_t v = in[i];
+        out[i] = (uint8_t)(v < 0 ? 0 : (v > 127 ? 127 : v));
+    }
+#endif
+}
+
+// Dot product of unsigned activations with int8 weights (n is a multiple of 32)
+static int32_t dotProduct(const uint8_t* x, const int8_t* w, int n) {
+#if defined(__AVX2__)
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 32) {
+        // Activations are at most 127, so the pairwise int16 sums cannot saturate
+        __m256i product = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)(x + i)),
+                                               _mm256_loadu_si256((const __m256i*)(w + i)));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(product, ones));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+#elif defined(__SSSE3__)
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < n; i += 16) {
+        __m128i product = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i*)(x + i)),
+                                            _mm_loadu_si128((const __m128i*)(w + i)));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(product, ones));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+#else
+    int32_t sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += (int32_t)x[i] * w[i];
+    }
+    return sum;
+#endif
+}
+
+// ---------------------------
+// NNUEEvaluator Implementation
+// ---------------------------
+
+NNUEEvaluator::NNUEEvaluator() {
+    featureBias = 0;
+    featureWeights = 0;
+    l1Bias = 0;
+    l1Weights = 0;
+    outputBias = 0;
+    outputWeights = 0;
+    hidden = 0;
+    l1Size = 0;
+    outputScale = 0;
+    loaded = false;
+}
+
+bool NNUEEvaluator::load(const uint8_t* blob, uint32_t size) {
+    loaded = false;
+    if (blob == 0 || size < NNUE_HEADER_SIZE || ((uintptr_t)blob & 3) != 0) return false;
+
+    uint32_t magic;
+    uint16_t version, hiddenSize, layerSize, scale;
+    memcpy(&magic, blob, 4);
+    memcpy(&version, blob + 4, 2);
+    memcpy(&hiddenSize, blob + 6, 2);
+    memcpy(&layerSize, blob + 8, 2);
+    memcpy(&scale, blob + 10, 2);
+
+    if (magic != NNUE_MAGIC || version != NNUE_VERSION) return false;
+    if (hiddenSize == 0 || hiddenSize > NNUE_MAX_HIDDEN || (hiddenSize % 32) != 0) return false;
+    if (layerSize == 0 || layerSize > NNUE_MAX_L1) return false;
+
+    uint32_t expected = NNUE_HEADER_SIZE
+                      + 2UL * hiddenSize                    // feature bias
+                      + 2UL * NNUE_INPUTS * hiddenSize      // feature weights
+                      + 4UL * layerSize                     // l1 bias
+                      + 2UL * hiddenSize * layerSize        // l1 weights
+                      + 4                                   // output bias
+                      + layerSize;                          // output weights
+    if (size != expected) return false;
+
+    const uint8_t* p = blob + NNUE_HEADER_SIZE;
+    featureBias = (const int16_t*)p;
+    p += 2UL * hiddenSize;
+    featureWeights = (const int16_t*)p;
+    p += 2UL * NNUE_INPUTS * hiddenSize;
+    l1Bias = (const int32_t*)p;
+    p += 4UL * layerSize;
+    l1Weights = (const int8_t*)p;
+    p += 2UL * hiddenSize * layerSize;
+    memcpy(&outputBias, p, 4);
+    p += 4;
+    outputWeights = (const int8_t*)p;
+
+    hidden = hiddenSize;
+    l1Size = layerSize;
+    outputScale = scale;
+    loaded = true;
+    return true;
+}
+
+// Each perspective sees its own pieces first and the board from its own side
+int NNUEEvaluator::featureIndex(int perspective, char piece, int square) const {
+    int index = pieceIndex(piece);
+    if (perspective == 1) {
+        index = (index + 6) % 12;
+        square ^= 56;
+    }
+    return index * 64 + square;
+}
+
+void NNUEEvaluator::refresh(const Position &pos, NNUEAccumulator &acc) const {
+    for (int perspective = 0; perspective < 2; perspective++) {
+        int16_t* values = acc.values[perspective];
+        memcpy(values, featureBias, hidden * sizeof(int16_t));
+        for (int square = 0; square < 64; square++) {
+            char piece = pos.board[square >> 3][square & 7];
+            if (piece == ' ') continue;
+            const int16_t* row = featureWeights + featureIndex(perspective, piece, square) * hidden;
+            accumulate(values, values, &row, 1, 0, 0, hidden);
+        }
+    }
+}
+
+void NNUEEvaluator::update(const NNUEAccumulator &parent, NNUEAccumulator &child,
+                           const Position &after, Move move, const MoveUndo &undo) const {
+    int from = moveFrom(move);
+    int to = moveTo(move);
+    char placed = after.board[to >> 3][to & 7];
+    bool isPawn = (undo.movedPiece == 'P' || undo.movedPiece == 'p');
+    bool isKing = (undo.movedPiece == 'K' || undo.movedPiece == 'k');
+
+    // En passant takes the pawn beside the target; castling also moves a rook
+    int capturedSquare = (isPawn && to == undo.epSquare) ? (from & ~7) | (to & 7) : to;
+    int rookFrom = -1, rookTo = -1;
+    if (isKing && (to - from == 2 || from - to == 2)) {
+        rookFrom = to > from ? from + 3 : from - 4;
+        rookTo = to > from ? from + 1 : from - 1;
+    }
+
+    for (int perspective = 0; perspective < 2; perspective++) {
+        const int16_t* add[2];
+        const int16_t* sub[2];
+        int addCount = 0;
+        int subCount = 0;
+
+        add[addCount++] = featureWeights + featureIndex(perspective, placed, to) * hidden;
+        sub[subCount++] = featureWeights + featureIndex(perspective, undo.movedPiece, from) * hidden;
+        if (undo.capturedPiece != ' ') {
+            sub[subCount++] = featureWeights + featureIndex(perspective, undo.capturedPiece, capturedSquare) * hidden;
+        }
+        if (rookFrom >= 0) {
+            char rook = after.board[rookTo >> 3][rookTo & 7];
+            add[addCount++] = featureWeights + featureIndex(perspective, rook, rookTo) * hidden;
+            sub[subCount++] = featureWeights + featureIndex(perspective, rook, rookFrom) * hidden;
+        }
+        accumulate(child.values[perspective], parent.values[perspective], add, addCount, sub, subCount, hidden);
+    }
+}
+
+int NNUEEvaluator::evaluate(const NNUEAccumulator &acc, bool whiteToMove) const {
+    uint8_t input[2 * NNUE_MAX_HIDDEN];
+    int us = whiteToMove ? 0 : 1;
+    clippedReLU(acc.values[us], input, hidden);
+    clippedReLU(acc.values[us ^ 1], input + hidden, hidden);
+
+    int32_t output = outputBias;
+    for (int j = 0; j < l1Size; j++) {
+        int32_t sum = l1Bias[j] + dotProduct(input, l1Weights + j * 2 * hidden, 2 * hidden);
+        sum >>= NNUE_L1_SHIFT;
+        if (sum < 0) sum = 0;
+        if (sum > 127) sum = 127;
+        output += sum * outputWeights[j];
+    }
+    return (int)(((int64_t)output * outputScale) >> NNUE_OUTPUT_SHIFT);
+}
@@ -0,0 +1,82 @@
+#ifndef CHESS_NNUE_H
+#define CHESS_NNUE_H
+
+#include <stdint.h>
+#include "chess_position.h"
+
+// The int16 accumulator stack costs about 1 KB per search ply, so NNUE
+// evaluation is only compiled in on hosts and on boards with enough RAM
+#if !defined(ARDUINO) || defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+  #define NNUE_ENABLED
+#endif
+
+// ---------------------------
+// Network Configuration
+// ---------------------------
+#define NNUE_INPUTS         768     // 12 piece types x 64 squares
+#define NNUE_MAX_HIDDEN     256     // Feature transformer width per perspective
+#define NNUE_MAX_L1         32      // Width of the int8 hidden layer
+#define NNUE_MAGIC          0x4E4E434FUL  // "OCNN" little-endian
+#define NNUE_VERSION        1
+
+// Network blob layout (little-endian, blob must be 4-byte aligned):
+//   header   uint32 magic, uint16 version, uint16 hidden,
+//            uint16 l1Size, uint16 outputScale, uint32 reserved   (16 bytes)
+//   int16    featureBias[hidden]
+//   int16    featureWeights[NNUE_INPUTS][hidden]
+//   int32    l1Bias[l1Size]
+//   int8     l1Weights[l1Size][2 * hidden]
+//   int32    outputBias
+//   int8     outputWeights[l1Size]
+// hidden must be a multiple of 32. Layer-one sums are shifted right by 6
+// before clamping, and centipawns = output * outputScale / 4096. The
+// evaluator reads the weights in place, so a blob kept in flash is never
+// copied to RAM.
+
+// ---------------------------
+// Accumulator
+// ---------------------------
+// First-layer sums for both perspectives (0 = White, 1 = Black). The search
+// keeps one per ply and derives each child from its parent on makeMove, so
+// unmakeMove is just dropping back to the parent.
+struct NNUEAccumulator {
+    int16_t values[2][NNUE_MAX_HIDDEN];
+};
+
+// ---------------------------
+// NNUE Evaluator Class
+// ---------------------------
+class NNUEEvaluator {
+private:
+    const int16_t* featureBias;
+    const int16_t* featureWeights;
+    const int32_t* l1Bias;
+    const int8_t* l1Weights;
+    int32_t outputBias;
+    const int8_t* outputWeights;
+    int hidden;
+    int l1Size;
+    int outputScale;
+    bool loaded;
+
+    int featureIndex(int perspective, char piece, int square) const;
+
+public:
+    NNUEEvaluator();
+
+    // Point the evaluator at a network blob; returns false if it is malformed
+    bool load(const uint8_t* blob, uint32_t size);
+    bool isLoaded() const { return loaded; }
+
+    // Rebuild an accumulator from scratch
+    void refresh(const Position &pos, NNUEAccumulator &acc) const;
+
+    // Derive the accumulator after a move from the one before it
+    void update(const NNUEAccumulator &parent, NNUEAccumulator &child,
+                const Position &after, Move move, const MoveUndo &undo) const;
+
+    // Score in centipawns from the side to move's point of view
+    int evaluate(const NNUEAccumulator &acc, bool whiteToMove) const;
+};
+
+#endif // CHESS_NNUE_H
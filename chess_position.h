@@ -0,0 +1,115 @@
+#ifndef CHESS_POSITION_H
+#define CHESS_POSITION_H
+
+#include <stdint.h>
+
+// ---------------------------
+// Search Move Encoding
+// ---------------------------
+// Squares are numbered row * 8 + col, using the same board layout as the
+// game modes (row 0 = rank 1, col 0 = file a). A move packs the from square,
+// the to square and an optional promotion piece into 16 bits.
+typedef uint16_t Move;
+
+#define MOVE_NONE       0
+#define MAX_MOVES       256     // Upper bound on pseudo-legal moves in a position
+
+#define PROMOTE_NONE    0
+#define PROMOTE_KNIGHT  1
+#define PROMOTE_BISHOP  2
+#define PROMOTE_ROOK    3
+#define PROMOTE_QUEEN   4
+
+static inline Move encodeMove(int from, int to, int promotion = PROMOTE_NONE) {
+    return (Move)(from | (to << 6) | (promotion << 12));
+}
+static inline int moveFrom(Move move) { return move & 63; }
+static inline int moveTo(Move move) { return (move >> 6) & 63; }
+static inline int movePromotion(Move move) { return (move >> 12) & 7; }
+
+// Map a piece character to 0-5 (white PNBRQK) or 6-11 (black), -1 if empty
+static inline int pieceIndex(char piece) {
+    switch (piece) {
+        case 'P': return 0;
+        case 'N': return 1;
+        case 'B': return 2;
+        case 'R': return 3;
+        case 'Q': return 4;
+        case 'K': return 5;
+        case 'p': return 6;
+        case 'n': return 7;
+        case 'b': return 8;
+        case 'r': return 9;
+        case 'q': return 10;
+        case 'k': return 11;
+    }
+    return -1;
+}
+
+// Castling rights
+#define CASTLE_WHITE_KING   0x01
+#define CASTLE_WHITE_QUEEN  0x02
+#define CASTLE_BLACK_KING   0x04
+#define CASTLE_BLACK_QUEEN  0x08
+
+#define FEN_MAX_LENGTH      92      // Longest FEN ChessEngine::formatFEN writes, with the NUL
+
+// ---------------------------
+// Position
+// ---------------------------
+// The whole game state: board, side to move, castling rights, en passant
+// square and both move counters. ChessEngine::makeMove/unmakeMove keep
+// all of it, including the hash, up to date incrementally. Castling is
+// encoded as the king's two-square move, en passant as the pawn's capture
+// onto epSquare.
+//
+// epSquare is only set when a pawn of the side to move could capture
+// there, so the FEN and hash of a position do not depend on whether the
+// last move happened to be a double push.
+struct Position {
+    char board[8][8];
+    bool whiteToMove;
+    uint8_t castling;           // CASTLE_* bits
+    int8_t epSquare;            // Square behind a pawn that just moved two, -1 if none
+    uint8_t halfmoveClock;      // Plies since the last pawn move or capture
+    uint16_t fullmoveNumber;    // Starts at 1, incremented after Black moves
+    uint64_t hash;
+};
+
+// Everything makeMove changes that cannot be recomputed from the move itself.
+// For en passant capturedPiece is the pawn taken, which stood beside the
+// target square rather than on it.
+struct MoveUndo {
+    char movedPiece;
+    char capturedPiece;
+    uint8_t castling;
+    int8_t epSquare;
+    uint8_t halfmoveClock;
+    uint64_t hash;
+};
+
+// ---------------------------
+// Packed Position
+// ---------------------------
+// Compact binary form of a position for storage and transfer: an occupancy
+// bitboard, then one pieceIndex() nibble per occupied square in ascending
+// square order, then the state. Every field is made of bytes (wider values
+// least significant byte first), so the struct can go to flash, a cache or
+// the wire as is and reads back the same on any board.
+#define PACKED_POSITION_SIZE    32
+#define PACKED_HEX_LENGTH       (2 * PACKED_POSITION_SIZE)
+
+#define PACKED_BLACK_TO_MOVE    0x01
+#define PACKED_CASTLING_SHIFT   1       // CASTLE_* bits live in flags bits 1-4
+
+struct PackedPosition {
+    uint8_t occupancy[8];       // Bit = row * 8 + col
+    uint8_t pieces[16];         // Two pieces per byte, low nibble first
+    uint8_t flags;              // PACKED_BLACK_TO_MOVE and castling rights
+    uint8_t enPassant;          // epSquare + 1, 0 if none
+    uint8_t halfmoveClock;
+    uint8_t fullmoveNumber[2];
+    uint8_t reserved[3];        // Zero
+};
+
+#endif // CHESS_POSITION_H
@@ -0,0 +1,272 @@
+#include "chess_puzzle.h"
+#include "chess_codec.h"
+#include <Arduino.h>
+
+// Moves in coordinate notation, e.g. e2e4
+static void printPuzzleMove(Move move) {
+    char text[MOVE_TEXT_SIZE];
+    formatUciMove(move, text);
+    Serial.print(text);
+}
+
+ChessPuzzle::ChessPuzzle(BoardDriver* bd, ChessEngine* ce) : solver(ce), database(ce), replySteps(bd) {
+    boardDriver = bd;
+    chessEngine = ce;
+    bucket = PuzzleDB::bucketFor(PUZZLE_DEFAULT_RATING);
+    ply = 0;
+    onSolutionLine = true;
+    movesLeft = 0;
+    puzzleActive = false;
+    mistakes = 0;
+    selectedRow = selectedCol = -1;
+    piecePickedUp = false;
+    replyTo = -1;
+    replyCaptured = false;
+}
+
+void ChessPuzzle::begin() {
+    Serial.println("=== Starting Puzzle Mode ===");
+    Serial.print("Puzzles available: ");
+    Serial.println(database.count());
+
+    boardDriver->clearOverlay();
+    boardDriver->clearAllLEDs();
+    boardDriver->showLEDs();
+
+    // The time the player took to choose the mode is as good a seed as any
+    randomSeed(micros());
+    nextPuzzle();
+}
+
+void ChessPuzzle::nextPuzzle() {
+    puzzleActive = false;
+
+    // Fall back to the nearest bucket that has puzzles
+    int chosen = -1;
+    for (int distance = 0; distance < PUZZLE_BUCKET_COUNT && chosen < 0; distance++) {
+        if (database.bucketSize(bucket - distance) > 0) chosen = bucket - distance;
+        else if (database.bucketSize(bucket + distance) > 0) chosen = bucket + distance;
+    }
+    if (chosen < 0 || !database.load(chosen, random(database.bucketSize(chosen)), puzzle)) {
+        Serial.println("No puzzles in the database!");
+        return;
+    }
+
+    pos = puzzle.pos;
+    ply = 0;
+    onSolutionLine = true;
+    movesLeft = puzzle.mateIn;
+    mistakes = 0;
+    piecePickedUp = false;
+    selectedRow = selectedCol = -1;
+    replySteps.cancel();
+
+    Serial.print("Puzzle rated ");
+    Serial.print(puzzle.rating);
+    Serial.print(": ");
+    Serial.print(pos.whiteToMove ? "White" : "Black");
+    Serial.print(" to move and mate in ");
+    Serial.println(puzzle.mateIn);
+
+    waitForPosition();
+    puzzleActive = true;
+}
+
+// Blocks until the pieces on the board match pos: missing pieces are lit
+// white, pieces on squares that should be empty red
+void ChessPuzzle::waitForPosition() {
+    Serial.println("Please set up the position shown on the board...");
+
+    uint64_t wanted = BoardDriver::occupancyOf(pos.board);
+    for (;;) {
+        boardDriver->readSensors();
+        uint64_t present = boardDriver->getOccupancy();
+        uint64_t missing = wanted & ~present;
+        uint64_t extra = present & ~wanted;
+        boardDriver->clearAllLEDs();
+        for (int square = 0; square < 64; square++) {
+            if ((missing >> square) & 1) boardDriver->setSquareLED(square >> 3, square & 7, 0, 0, 0, 255);
+            else if ((extra >> square) & 1) boardDriver->setSquareLED(square >> 3, square & 7, 255, 0, 0);
+        }
+        boardDriver->showLEDs();
+        if (!(missing | extra)) break;
+        delay(100);
+    }
+
+    boardDriver->clearAllLEDs();
+    boardDriver->showLEDs();
+    boardDriver->updateSensorPrev();
+    Serial.println("Position ready. Your move!");
+}
+
+void ChessPuzzle::update() {
+    if (!puzzleActive) return;
+
+    // The defence's reply has to be on the board before the player goes on
+    if (replySteps.pending()) {
+        if (replySteps.follow()) finishReply();
+        boardDriver->updateSensorPrev();
+        return;
+    }
+
+    // Lifts from the scanner select a piece, placements play it
+    SensorEvent event;
+    while (puzzleActive && !replySteps.pending() && boardDriver->pollEvent(event)) {
+        int row = event.square >> 3;
+        int col = event.square & 7;
+
+        if (!piecePickedUp && event.type == SENSOR_LIFT) {
+            char piece = pos.board[row][col];
+            bool isPlayerPiece = pos.whiteToMove ? (piece >= 'A' && piece <= 'Z') : (piece >= 'a' && piece <= 'z');
+            if (!isPlayerPiece) {
+                Serial.println("That is not one of your pieces!");
+                boardDriver->blinkSquare(row, col, 3);
+                continue;
+            }
+
+            selectedRow = row;
+            selectedCol = col;
+            piecePickedUp = true;
+
+            // Show the selected square and its moves
+            boardDriver->clearAllLEDs();
+            boardDriver->setSquareLED(row, col, 255, 0, 0);
+            int moveCount = 0;
+            int moves[27][2];
+            chessEngine->getPossibleMoves(pos, row, col, moveCount, moves);
+            for (int i = 0; i < moveCount; i++) {
+                boardDriver->setSquareLED(moves[i][0], moves[i][1], 0, 0, 0, 255);
+            }
+            boardDriver->showLEDs();
+        } else if (piecePickedUp && event.type == SENSOR_PLACE) {
+            if (row == selectedRow && col == selectedCol) {
+                Serial.println("Piece returned to original position. Selection cancelled.");
+                piecePickedUp = false;
+                selectedRow = selectedCol = -1;
+                boardDriver->clearAllLEDs();
+                boardDriver->showLEDs();
+            } else {
+                playerMove(selectedRow, selectedCol, row, col);
+            }
+        }
+    }
+
+    // Scan at full rate while a piece is in hand
+    boardDriver->setScanHold(piecePickedUp);
+    boardDriver->updateSensorPrev();
+}
+
+void ChessPuzzle::playerMove(int fromRow, int fromCol, int toRow, int toCol) {
+    char piece = pos.board[fromRow][fromCol];
+    int promotion = chessEngine->isPawnPromotion(piece, toRow) ? PROMOTE_QUEEN : PROMOTE_NONE;
+    Move move = encodeMove(fromRow * 8 + fromCol, toRow * 8 + toCol, promotion);
+
+    if (!chessEngine->isLegalMove(pos, move)) {
+        // Piece stays selected, as in the other game modes
+        Serial.println("Invalid move! Please try again.");
+        boardDriver->blinkSquare(toRow, toCol, 3);
+        return;
+    }
+
+    piecePickedUp = false;
+    selectedRow = selectedCol = -1;
+
+    // The stored move is a comparison; anything else goes to the solver
+    bool accepted = onSolutionLine && move == puzzle.solution[ply];
+    bool offLine = !accepted;
+    if (!accepted) {
+        unsigned long started = millis();
+        accepted = solver.isMatingMove(pos, move, movesLeft, PUZZLE_SOLVER_NODES);
+        Serial.print("Solver checked ");
+        printPuzzleMove(move);
+        Serial.print(" in ");
+        Serial.print(millis() - started);
+        Serial.println(" ms");
+    }
+
+    if (!accepted) {
+        mistakes++;
+        if (solver.wasAborted()) {
+            Serial.println("Could not verify that move in time - try another.");
+        } else {
+            Serial.println("That move does not force mate. Put the piece back and try again.");
+        }
+        boardDriver->warnSquare(toRow, toCol);
+        waitForPosition();
+        return;
+    }
+
+    MoveUndo undo;
+    chessEngine->makeMove(pos, move, undo);
+    if (undo.capturedPiece != ' ') boardDriver->captureAnimation();
+    if (promotion != PROMOTE_NONE) boardDriver->promotionAnimation(toCol);
+    confirmSquare(toRow, toCol);
+
+    if (offLine && onSolutionLine) {
+        Serial.println("Not the book move, but it mates too!");
+        onSolutionLine = false;
+    }
+    ply++;
+
+    if (isMate()) {
+        Serial.print("Checkmate! Puzzle solved");
+        Serial.println(mistakes == 0 ? " first time." : ".");
+        boardDriver->fireworkAnimation();
+
+        // Clean solves move on to harder puzzles
+        if (mistakes == 0 && bucket + 1 < PUZZLE_BUCKET_COUNT && database.bucketSize(bucket + 1) > 0) bucket++;
+        nextPuzzle();
+        return;
+    }
+
+    movesLeft--;
+    defenderMove();
+}
+
+void ChessPuzzle::defenderMove() {
+    Move reply;
+    if (onSolutionLine && ply < puzzle.solutionLength) {
+        reply = puzzle.solution[ply];
+    } else {
+        reply = solver.bestDefence(pos, movesLeft, PUZZLE_SOLVER_NODES);
+    }
+    ply++;
+
+    Serial.print("Defence plays ");
+    printPuzzleMove(reply);
+    Serial.println();
+
+    // Same handshake as the bot's moves: lift from the blinking source, place
+    // on the destination; update() follows it and then confirms the reply
+    MoveUndo undo;
+    chessEngine->makeMove(pos, reply, undo);
+    replyTo = moveTo(reply);
+    replyCaptured = undo.capturedPiece != ' ';
+    replySteps.addMove(reply, undo, true);
+}
+
+void ChessPuzzle::finishReply() {
+    if (replyCaptured) boardDriver->captureAnimation();
+    confirmSquare(replyTo >> 3, replyTo & 7);
+
+    Serial.print("Your move: mate in ");
+    Serial.println(movesLeft);
+}
+
+bool ChessPuzzle::isMate() {
+    Move moves[MAX_MOVES];
+    return chessEngine->generateLegalMoves(pos, moves) == 0 && chessEngine->isInCheck(pos, pos.whiteToMove);
+}
+
+void ChessPuzzle::confirmSquare(int row, int col) {
+    boardDriver->clearAllLEDs();
+    boardDriver->flashSquares(1ULL << (row * 8 + col), BoardDriver::color(0, 255, 0), 2, 300);
+}
+
+void ChessPuzzle::getBoardState(char boardState[8][8]) {
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            boardState[row][col] = pos.board[row][col];
+        }
+    }
+}
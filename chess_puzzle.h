@@ -0,0 +1,71 @@
+#ifndef CHESS_PUZZLE_H
+#define CHESS_PUZZLE_H
+
+#include "board_driver.h"
+#include "board_steps.h"
+#include "chess_engine.h"
+#include "chess_mate.h"
+#include "puzzle_db.h"
+
+// ---------------------------
+// Puzzle Mode Configuration
+// ---------------------------
+#define PUZZLE_DEFAULT_RATING   1000
+#define PUZZLE_SOLVER_NODES     20000   // Per check of an off-book move; keeps the answer under a second
+
+// ---------------------------
+// Puzzle Game Mode Class
+// ---------------------------
+// Mate puzzles from the compiled-in database. The player sets up the
+// puzzle position, then plays the attacking side while the board answers
+// with the defence. A move matching the stored solution is accepted with a
+// single comparison; any other legal move is handed to the mate solver, so
+// alternative mates count too, and after one the board defends with the
+// solver's most stubborn reply instead of the stored line.
+class ChessPuzzle {
+private:
+    BoardDriver* boardDriver;
+    ChessEngine* chessEngine;
+    MateSolver solver;
+    PuzzleDB database;
+
+    Puzzle puzzle;
+    Position pos;
+    int bucket;
+    int ply;                // Next ply of puzzle.solution while on the stored line
+    bool onSolutionLine;
+    int movesLeft;          // Attacker moves left to mate, counting the next one
+    bool puzzleActive;
+    int mistakes;
+
+    int selectedRow, selectedCol;
+    bool piecePickedUp;
+
+    // The defence's reply, already played in pos, until the player has made
+    // it on the board too
+    BoardSteps replySteps;
+    int replyTo;
+    bool replyCaptured;
+
+    void nextPuzzle();
+    void waitForPosition();
+    void playerMove(int fromRow, int fromCol, int toRow, int toCol);
+    void defenderMove();
+    void finishReply();
+    bool isMate();
+    void confirmSquare(int row, int col);
+
+public:
+    ChessPuzzle(BoardDriver* bd, ChessEngine* ce);
+    void begin();
+    void update();
+
+    // Picks the rating bucket of the next puzzle
+    void setRating(int rating) { bucket = PuzzleDB::bucketFor(rating); }
+
+    // Get current board state for WiFi display
+    void getBoardState(char boardState[8][8]);
+    bool isWhiteToMove() { return pos.whiteToMove; }
+};
+
+#endif // CHESS_PUZZLE_H
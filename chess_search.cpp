@@ -0,0 +1,408 @@
+#include "chess_search.h"
+
+// ---------------------------
+// ChessSearch Implementation
+// ---------------------------
+
+// Rough material values in centipawns for capture ordering
+static int pieceValue(char piece) {
+    switch (piece) {
+        case 'P': case 'p': return 100;
+        case 'N': case 'n': return 320;
+        case 'B': case 'b': return 330;
+        case 'R': case 'r': return 500;
+        case 'Q': case 'q': return 900;
+        case 'K': case 'k': return 20000;
+    }
+    return 0;
+}
+
+// Mate scores are stored relative to the node, not the root
+static int scoreToTT(int score, int ply) {
+    if (score >= SCORE_MATE - SEARCH_MAX_PLY) return score + ply;
+    if (score <= -SCORE_MATE + SEARCH_MAX_PLY) return score - ply;
+    return score;
+}
+
+static int scoreFromTT(int score, int ply) {
+    if (score >= SCORE_MATE - SEARCH_MAX_PLY) return score - ply;
+    if (score <= -SCORE_MATE + SEARCH_MAX_PLY) return score + ply;
+    return score;
+}
+
+ChessSearch::ChessSearch(const ChessEngine* ce, const NNUEEvaluator* evaluator) : engine(ce), nnue(evaluator), eval(ce) {
+    tt = 0;
+    observer = 0;
+    ply = 0;
+    nodes = 0;
+    completedDepth = 0;
+    nodeLimit = 0;
+    evalNoise = 0;
+    canStop = false;
+    stopped = false;
+    stopRequested = false;
+    moveStackTop = 0;
+}
+
+Move ChessSearch::findBestMove(const char board[8][8], bool whiteToMove, const ChessHistory &gameHistory,
+                               const SearchLimits &limits, int &score) {
+    Position start;
+    engine->setupPosition(start, board, whiteToMove);
+    return findBestMove(start, gameHistory, limits, score);
+}
+
+Move ChessSearch::findBestMove(const Position &start, const ChessHistory &gameHistory,
+                               const SearchLimits &limits, int &score) {
+    SearchLine line;
+    int count = analyze(start, gameHistory, limits, &line, 1);
+    score = line.score;
+    return count > 0 ? line.pv[0] : MOVE_NONE;
+}
+
+Move ChessSearch::findBestMove(const GameContext &game, const SearchLimits &limits, int &score) {
+    return findBestMove(game.pos, game.history, limits, score);
+}
+
+int ChessSearch::analyze(const GameContext &game, const SearchLimits &limits, SearchLine lines[], int lineCount) {
+    return analyze(game.pos, game.history, limits, lines, lineCount);
+}
+
+int ChessSearch::analyze(const char board[8][8], bool whiteToMove, const ChessHistory &gameHistory,
+                         const SearchLimits &limits, SearchLine lines[], int lineCount) {
+    Position start;
+    engine->setupPosition(start, board, whiteToMove);
+    return analyze(start, gameHistory, limits, lines, lineCount);
+}
+
+int ChessSearch::analyze(const Position &start, const ChessHistory &gameHistory,
+                         const SearchLimits &limits, SearchLine lines[], int lineCount) {
+    pos = start;
+    history = gameHistory;
+    ply = 0;
+    nodes = 0;
+    completedDepth = 0;
+    moveStackTop = 0;
+    timer.start(limits.moveTimeMs);
+    nodeLimit = limits.nodeLimit;
+    evalNoise = limits.evalNoise;
+    canStop = limits.hardLimit;
+    stopped = false;
+    stopRequested = false;
+    if (tt) tt->newSearch();
+    lines[0].pvLength = 0;
+    lines[0].score = 0;
+
+#ifdef NNUE_ENABLED
+    if (useNNUE()) nnue->refresh(pos, accumulators[0]);
+#endif
+
+    Move rootMoves[MAX_MOVES];
+    int rootCount = engine->generateLegalMoves(pos, rootMoves);
+    if (rootCount == 0) {
+        lines[0].score = engine->isInCheck(pos, pos.whiteToMove) ? -SCORE_MATE : 0;
+        return 0;
+    }
+    orderMoves(rootMoves, rootCount, MOVE_NONE, false);
+
+    if (lineCount > MAX_PV_LINES) lineCount = MAX_PV_LINES;
+    if (lineCount > rootCount) lineCount = rootCount;
+    int filled = 0;
+    int maxDepth = limits.maxDepth < SEARCH_MAX_DEPTH ? limits.maxDepth : SEARCH_MAX_DEPTH;
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        SearchLine current[MAX_PV_LINES];
+        int found = 0;
+
+        for (int i = 0; i < rootCount; i++) {
+            // Until the list is full every move gets an exact score
+            int alpha = found < lineCount ? -SCORE_INFINITE : current[lineCount - 1].score;
+
+            MoveUndo undo;
+            int clock = history.getHalfmoveClock();
+            makeSearchMove(rootMoves[i], undo);
+            int value = -negamax(depth - 1, -SCORE_INFINITE, -alpha);
+            unmakeSearchMove(rootMoves[i], undo, clock);
+
+            if (stopped) break;
+            if (value > alpha) insertLine(current, found, lineCount, rootMoves[i], value);
+        }
+        
+        // An interrupted iteration is incomplete; keep the previous one
+        if (stopped) break;
+
+        // Search the best lines first on the next iteration, in rank order
+        for (int j = found - 1; j >= 0; j--) {
+            int index = 0;
+            while (rootMoves[index] != current[j].pv[0]) index++;
+            for (; index > 0; index--) rootMoves[index] = rootMoves[index - 1];
+            rootMoves[0] = current[j].pv[0];
+        }
+        for (int j = 0; j < found; j++) lines[j] = current[j];
+        filled = found;
+        completedDepth = depth;
+        canStop = true;
+        if (observer) observer->iterationComplete(depth, lines, filled, nodes, timer.elapsed());
+
+        // No point searching deeper once every line is a forced mate
+        bool allMates = true;
+        for (int j = 0; j < found; j++) {
+            int score = current[j].score;
+            if (score < SCORE_MATE - SEARCH_MAX_PLY && score > -SCORE_MATE + SEARCH_MAX_PLY) allMates = false;
+        }
+        if (allMates) break;
+        
+        // Stop early when the best move is settled; keep going when the score drops
+        timer.iterationComplete(current[0].pv[0], current[0].score);
+        if (timer.softExpired()) break;
+    }
+    return filled;
+}
+
+// Insert a root move into the score-ordered line list, keeping at most
+// lineCount entries. Its continuation is the PV just left at ply 1.
+void ChessSearch::insertLine(SearchLine lines[], int &found, int lineCount, Move move, int score) {
+    int j = found < lineCount ? found++ : lineCount - 1;
+    while (j > 0 && lines[j - 1].score < score) {
+        lines[j] = lines[j - 1];
+        j--;
+    }
+
+    SearchLine &line = lines[j];
+    line.pv[0] = move;
+    line.pvLength = 1;
+    for (int i = 1; i < pvLength[1]; i++) line.pv[line.pvLength++] = pvTable[1][i];
+    line.score = score;
+}
+
+int ChessSearch::negamax(int depth, int alpha, int beta) {
+    pvLength[ply] = ply;
+    if (ply > 0 && (history.isFiftyMoveDraw() || history.isRepetition())) return 0;
+    if (depth <= 0) return quiescence(alpha, beta);
+    if (ply >= SEARCH_MAX_PLY || moveStackTop + MAX_MOVES > MOVE_STACK_SIZE) return evaluate();
+    nodes++;
+    if (checkLimits()) return 0;
+
+    // A deep enough stored result can settle the node; otherwise its move goes first
+    Move ttMove = MOVE_NONE;
+    TTEntry entry;
+    if (tt && tt->probe(pos.hash, entry)) {
+        ttMove = entry.move;
+        if (entry.depth >= depth) {
+            int score = scoreFromTT(entry.score, ply);
+            int bound = entry.boundAndAge & 3;
+            if (bound == TT_BOUND_EXACT || (bound == TT_BOUND_LOWER && score >= beta) ||
+                (bound == TT_BOUND_UPPER && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    Move* moves = moveStack + moveStackTop;
+    int count = engine->generateMoves(pos, moves);
+    orderMoves(moves, count, ttMove, false);
+    moveStackTop += count;
+
+    bool white = pos.whiteToMove;
+    int originalAlpha = alpha;
+    int legalMoves = 0;
+    int bestScore = -SCORE_INFINITE;
+    Move bestMove = MOVE_NONE;
+
+    for (int i = 0; i < count; i++) {
+        MoveUndo undo;
+        int clock = history.getHalfmoveClock();
+        makeSearchMove(moves[i], undo);
+        if (engine->isInCheck(pos, white)) {
+            unmakeSearchMove(moves[i], undo, clock);
+            continue;
+        }
+        legalMoves++;
+        int value = -negamax(depth - 1, -beta, -alpha);
+        unmakeSearchMove(moves[i], undo, clock);
+        if (stopped) break;
+
+        if (value > bestScore) {
+            bestScore = value;
+            bestMove = moves[i];
+            if (value > alpha) {
+                alpha = value;
+                updatePV(moves[i]);
+            }
+            if (alpha >= beta) break;
+        }
+    }
+    moveStackTop -= count;
+
+    if (legalMoves == 0) {
+        // Checkmate or stalemate; prefer the quickest mate
+        return engine->isInCheck(pos, white) ? -SCORE_MATE + ply : 0;
+    }
+    
+    if (tt && !stopped) {
+        int bound = bestScore >= beta ? TT_BOUND_LOWER : (bestScore > originalAlpha ? TT_BOUND_EXACT : TT_BOUND_UPPER);
+        Move move = bound == TT_BOUND_UPPER ? MOVE_NONE : bestMove;
+        tt->store(pos.hash, move, scoreToTT(bestScore, ply), depth, bound);
+    }
+    return bestScore;
+}
+
+// Resolve captures and promotions so the evaluation is taken at a quiet position
+int ChessSearch::quiescence(int alpha, int beta) {
+    pvLength[ply] = ply;
+    nodes++;
+    if (checkLimits()) return 0;
+    int standPat = evaluate();
+    if (ply >= SEARCH_MAX_PLY || moveStackTop + MAX_MOVES > MOVE_STACK_SIZE) return standPat;
+    if (standPat >= beta) return standPat;
+    if (standPat > alpha) alpha = standPat;
+
+    Move* moves = moveStack + moveStackTop;
+    int count = engine->generateMoves(pos, moves);
+    count = orderMoves(moves, count, MOVE_NONE, true);
+    moveStackTop += count;
+
+    bool white = pos.whiteToMove;
+    for (int i = 0; i < count; i++) {
+        MoveUndo undo;
+        int clock = history.getHalfmoveClock();
+        makeSearchMove(moves[i], undo);
+        if (engine->isInCheck(pos, white)) {
+            unmakeSearchMove(moves[i], undo, clock);
+            continue;
+        }
+        int value = -quiescence(-beta, -alpha);
+        unmakeSearchMove(moves[i], undo, clock);
+        if (stopped) break;
+
+        if (value > alpha) {
+            alpha = value;
+            updatePV(moves[i]);
+            if (alpha >= beta) break;
+        }
+    }
+    moveStackTop -= count;
+    return alpha;
+}
+
+int ChessSearch::resolveQuiet(Position &leaf) {
+    pos = leaf;
+    history.reset(pos.hash, pos.halfmoveClock);
+    ply = 0;
+    nodes = 0;
+    moveStackTop = 0;
+    nodeLimit = 0;
+    evalNoise = 0;
+    canStop = false;
+    stopped = false;
+    stopRequested = false;
+
+#ifdef NNUE_ENABLED
+    if (useNNUE()) nnue->refresh(pos, accumulators[0]);
+#endif
+
+    int score = quiescence(-SCORE_INFINITE, SCORE_INFINITE);
+    for (int i = 0; i < pvLength[0]; i++) {
+        MoveUndo undo;
+        engine->makeMove(leaf, pvTable[0][i], undo);
+    }
+    return score;
+}
+
+// Best line at this ply is move followed by the child's best line
+void ChessSearch::updatePV(Move move) {
+    pvTable[ply][ply] = move;
+    int length = pvLength[ply + 1];
+    for (int i = ply + 1; i < length; i++) pvTable[ply][i] = pvTable[ply + 1][i];
+    pvLength[ply] = length;
+}
+
+// The node budget is exact; the clock is read every SEARCH_CLOCK_INTERVAL
+// nodes and the observer polled every 1024. Once stopped, every node
+// unwinds at once.
+bool ChessSearch::checkLimits() {
+    if ((nodes & 1023) == 0 && observer) observer->poll();
+    if (!stopped && canStop) {
+        if (stopRequested || (nodeLimit != 0 && nodes >= nodeLimit)) stopped = true;
+        else if ((nodes & (SEARCH_CLOCK_INTERVAL - 1)) == 0 && timer.hardExpired()) stopped = true;
+    }
+    return stopped;
+}
+
+
+bool ChessSearch::useNNUE() {
+#ifdef NNUE_ENABLED
+    return nnue != 0 && nnue->isLoaded();
+#else
+    return false;
+#endif
+}
+
+int ChessSearch::evaluate() {
+    int score;
+#ifdef NNUE_ENABLED
+    if (useNNUE()) score = nnue->evaluate(accumulators[ply], pos.whiteToMove);
+    else score = eval.evaluate(pos);
+#else
+    score = eval.evaluate(pos);
+#endif
+
+    // Noise derived from the position hash, so weaker levels still replay exactly
+    if (evalNoise > 0) {
+        uint64_t x = pos.hash ^ 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        score += (int)(x % (uint64_t)(2 * evalNoise + 1)) - evalNoise;
+    }
+    return score;
+}
+
+// Sort moves best-first: the given first move, then captures and promotions
+// by most valuable victim / least valuable attacker, then quiet moves. With
+// capturesOnly the quiet moves are dropped and the new count is returned.
+int ChessSearch::orderMoves(Move moves[], int count, Move first, bool capturesOnly) {
+    int scores[MAX_MOVES];
+    int kept = 0;
+
+    for (int i = 0; i < count; i++) {
+        Move move = moves[i];
+        char attacker = pos.board[moveFrom(move) >> 3][moveFrom(move) & 7];
+        char victim = pos.board[moveTo(move) >> 3][moveTo(move) & 7];
+
+        int score = 0;
+        if (move == first) {
+            score = 1000000;
+        } else if (victim != ' ' || movePromotion(move) != PROMOTE_NONE) {
+            score = 100000 + pieceValue(victim) * 16 - pieceValue(attacker) / 16 + movePromotion(move) * 1000;
+        } else if (capturesOnly) {
+            continue;
+        }
+
+        // Insertion sort; move lists are short
+        int j = kept;
+        while (j > 0 && scores[j - 1] < score) {
+            scores[j] = scores[j - 1];
+            moves[j] = moves[j - 1];
+            j--;
+        }
+        scores[j] = score;
+        moves[j] = move;
+        kept++;
+    }
+    return kept;
+}
+
+void ChessSearch::makeSearchMove(Move move, MoveUndo &undo) {
+    engine->makeMove(pos, move, undo);
+    history.push(pos.hash, pos.halfmoveClock == 0);
+#ifdef NNUE_ENABLED
+    if (useNNUE()) nnue->update(accumulators[ply], accumulators[ply + 1], pos, move, undo);
+#endif
+    ply++;
+}
+
+void ChessSearch::unmakeSearchMove(Move move, const MoveUndo &undo, int previousHalfmoveClock) {
+    ply--;
+    history.pop(previousHalfmoveClock);
+    engine->unmakeMove(pos, move, undo);
+}
@@ -0,0 +1,158 @@
+#ifndef CHESS_SEARCH_H
+#define CHESS_SEARCH_H
+
+#include "chess_engine.h"
+#include "chess_history.h"
+#include "chess_context.h"
+#include "chess_nnue.h"
+#include "chess_eval.h"
+#include "chess_time.h"
+#include "chess_tt.h"
+
+// ---------------------------
+// Search Configuration
+// ---------------------------
+#define SEARCH_MAX_PLY      32
+#define SEARCH_MAX_DEPTH    24      // Leaves room for quiescence below the deepest iteration
+#define MOVE_STACK_SIZE     2048    // Shared by all plies; a node needs at most MAX_MOVES
+#define SCORE_INFINITE      32000
+#define SCORE_MATE          31000   // Mate in n plies scores SCORE_MATE - n
+#define MAX_PV_LINES        4       // Most lines one analyze() call can return
+#define SEARCH_CLOCK_INTERVAL 128   // Nodes between clock reads (power of two); keeps short budgets tight on slow boards
+
+// Limits for one search; the search stops at whichever is reached first.
+// Node budgets and eval noise are deterministic: with no time limit (and a
+// cleared transposition table) the same position always gives the same move.
+struct SearchLimits {
+    int maxDepth = SEARCH_MAX_DEPTH;
+    uint32_t moveTimeMs = 0;        // Latency target, 0 = none
+    uint32_t nodeLimit = 0;         // Node budget, 0 = none
+    int evalNoise = 0;              // Leaf evaluations vary by up to +/- this many centipawns
+    bool hardLimit = false;         // Time and nodes may cut depth 1 short, leaving no move
+};
+
+// One root move with its score and principal variation (pv[0] is the move)
+struct SearchLine {
+    Move pv[SEARCH_MAX_PLY];
+    int pvLength;
+    int score;
+};
+
+// Receives progress from a running search, e.g. for UCI info output
+class SearchObserver {
+public:
+    virtual ~SearchObserver() {}
+
+    // After each completed iteration, with the lines found so far
+    virtual void iterationComplete(int /*depth*/, const SearchLine /*lines*/[], int /*lineCount*/,
+                                   uint32_t /*nodes*/, uint32_t /*elapsedMs*/) {}
+
+    // Every 1024 nodes; may call ChessSearch::requestStop
+    virtual void poll() {}
+};
+
+// ---------------------------
+// Local Search Class
+// ---------------------------
+// Alpha-beta search with quiescence on the on-board engine. Evaluates with
+// the NNUE network when one is loaded, and falls back to the hand-crafted
+// evaluation (chess_eval.h) otherwise. An instance is the scratch space of
+// one search at a time: hosts serving many games give each worker thread
+// its own ChessSearch (and table) over the shared engine and network.
+class ChessSearch {
+private:
+    const ChessEngine* engine;
+    const NNUEEvaluator* nnue;
+    ChessEval eval;
+    TranspositionTable* tt;
+    SearchObserver* observer;
+    
+    // State of the position being searched
+    Position pos;
+    ChessHistory history;
+    int ply;
+    uint32_t nodes;
+    int completedDepth;
+    
+    // Search limits; depth 1 always completes so there is a move to play,
+    // unless the limits are hard
+    TimeManager timer;
+    uint32_t nodeLimit;
+    int evalNoise;
+    bool canStop;
+    bool stopped;
+    bool stopRequested;
+    
+    // Move lists of all plies live in one stack to keep the C stack small
+    Move moveStack[MOVE_STACK_SIZE];
+    int moveStackTop;
+    
+    // Triangular principal variation table: pvTable[ply] holds the best line from ply
+    Move pvTable[SEARCH_MAX_PLY + 1][SEARCH_MAX_PLY + 1];
+    int pvLength[SEARCH_MAX_PLY + 1];
+    
+#ifdef NNUE_ENABLED
+    NNUEAccumulator accumulators[SEARCH_MAX_PLY + 1];
+#endif
+    
+    int negamax(int depth, int alpha, int beta);
+    int quiescence(int alpha, int beta);
+    int evaluate();
+    bool useNNUE();
+    bool checkLimits();
+    void updatePV(Move move);
+    void insertLine(SearchLine lines[], int &found, int lineCount, Move move, int score);
+    int orderMoves(Move moves[], int count, Move first, bool capturesOnly);
+    void makeSearchMove(Move move, MoveUndo &undo);
+    void unmakeSearchMove(Move move, const MoveUndo &undo, int previousHalfmoveClock);
+    
+public:
+    ChessSearch(const ChessEngine* ce, const NNUEEvaluator* evaluator = 0);
+    
+    // Iterative deepening within limits. Returns MOVE_NONE if there is no
+    // legal move (or hard limits cut depth 1 short); score is in centipawns
+    // for the side to move.
+    Move findBestMove(const char board[8][8], bool whiteToMove, const ChessHistory &gameHistory,
+                      const SearchLimits &limits, int &score);
+    
+    // Multi-PV search: the best lineCount root moves (up to MAX_PV_LINES),
+    // best first, from a single iterative deepening run. Root moves are
+    // searched against the score of the current N-th best line, so moves
+    // that cannot enter the list are cut off as in a single-PV search.
+    // Returns the number of lines filled; with no legal move it is 0 and
+    // lines[0].score holds the mate or stalemate score.
+    int analyze(const char board[8][8], bool whiteToMove, const ChessHistory &gameHistory,
+                const SearchLimits &limits, SearchLine lines[], int lineCount);
+    
+    // The same searches from a full position, keeping its castling rights
+    // and en passant square (the board overloads infer them)
+    Move findBestMove(const Position &start, const ChessHistory &gameHistory,
+                      const SearchLimits &limits, int &score);
+    int analyze(const Position &start, const ChessHistory &gameHistory,
+                const SearchLimits &limits, SearchLine lines[], int lineCount);
+    
+    // The same searches on the current position of a game
+    Move findBestMove(const GameContext &game, const SearchLimits &limits, int &score);
+    int analyze(const GameContext &game, const SearchLimits &limits, SearchLine lines[], int lineCount);
+    
+    // Quiescence-only search from leaf. On return leaf holds the quiet
+    // position at the end of the capture line; the score is for the side to
+    // move at the original position. Used by the Texel tuner.
+    int resolveQuiet(Position &leaf);
+    
+    // Optional transposition table and progress observer (null for none)
+    void setTranspositionTable(TranspositionTable* table) { tt = table; }
+    void setObserver(SearchObserver* searchObserver) { observer = searchObserver; }
+    
+    // Forget everything learned in the previous game
+    void newGame() { if (tt) tt->clear(); }
+    int hashfull() { return tt ? tt->hashfull() : 0; }
+    
+    // Stop as soon as depth 1 is complete; for use from SearchObserver::poll
+    void requestStop() { stopRequested = true; }
+    
+    uint32_t getNodes() { return nodes; }
+    int getCompletedDepth() { return completedDepth; }
+};
+
+#endif // CHESS_SEARCH_H
@@ -0,0 +1,70 @@
+#include "chess_time.h"
+
+#ifdef ARDUINO
+  #include <Arduino.h>
+#else
+  #include <time.h>
+#endif
+
+// ---------------------------
+// TimeManager Implementation
+// ---------------------------
+
+TimeManager::TimeManager() {
+    startTime = 0;
+    targetMs = 0;
+    softMs = 0;
+    lastBest = MOVE_NONE;
+    lastScore = 0;
+    stableIterations = 0;
+}
+
+uint32_t TimeManager::now() {
+#ifdef ARDUINO
+    return millis();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+#endif
+}
+
+void TimeManager::start(uint32_t latencyTargetMs) {
+    startTime = now();
+    targetMs = latencyTargetMs;
+    softMs = latencyTargetMs * TIME_SOFT_PERCENT / 100;
+    lastBest = MOVE_NONE;
+    lastScore = 0;
+    stableIterations = 0;
+}
+
+void TimeManager::iterationComplete(Move bestMove, int score) {
+    if (targetMs == 0) return;
+
+    int percent = 100;
+    if (lastBest != MOVE_NONE) {
+        if (bestMove == lastBest) {
+            stableIterations++;
+            if (stableIterations >= TIME_STABLE_ITERATIONS) percent = 50;
+            else percent = 80;
+        } else {
+            stableIterations = 0;
+            percent = 130;
+        }
+        // A falling score means trouble; spend longer finding the way out
+        if (score < lastScore - TIME_SCORE_DROP) percent = 200;
+    }
+    lastBest = bestMove;
+    lastScore = score;
+
+    softMs = targetMs * TIME_SOFT_PERCENT / 100 * percent / 100;
+    if (softMs > targetMs) softMs = targetMs;
+}
+
+bool TimeManager::softExpired() {
+    return targetMs != 0 && elapsed() >= softMs;
+}
+
+bool TimeManager::hardExpired() {
+    return targetMs != 0 && elapsed() >= targetMs;
+}
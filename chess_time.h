@@ -0,0 +1,48 @@
+#ifndef CHESS_TIME_H
+#define CHESS_TIME_H
+
+#include <stdint.h>
+#include "chess_position.h"
+
+// ---------------------------
+// Time Manager Configuration
+// ---------------------------
+#define TIME_SOFT_PERCENT       45  // Soft deadline as a share of the latency target
+#define TIME_STABLE_ITERATIONS  3   // Same best move this often halves the soft deadline
+#define TIME_SCORE_DROP         30  // Centipawn drop between iterations that extends the search
+
+// ---------------------------
+// Time Manager Class
+// ---------------------------
+// Deadlines for one iterative deepening search. The hard deadline is the
+// latency target and aborts the search mid-iteration; the soft deadline
+// decides whether another iteration is worth starting. It shrinks while the
+// best move stays the same and grows (up to the hard deadline) when the
+// score drops or the best move changes.
+class TimeManager {
+private:
+    uint32_t startTime;
+    uint32_t targetMs;
+    uint32_t softMs;
+    Move lastBest;
+    int lastScore;
+    int stableIterations;
+
+public:
+    TimeManager();
+
+    // Milliseconds since an arbitrary origin; millis() on the boards
+    static uint32_t now();
+
+    // Begin timing a search; a target of 0 means no time limit
+    void start(uint32_t latencyTargetMs);
+
+    // Feed the result of each completed iteration to adjust the soft deadline
+    void iterationComplete(Move bestMove, int score);
+
+    bool softExpired();
+    bool hardExpired();
+    uint32_t elapsed() { return now() - startTime; }
+};
+
+#endif // CHESS_TIME_H
@@ -0,0 +1,61 @@
+#include "chess_tt.h"
+#include <string.h>
+
+// ---------------------------
+// TranspositionTable Implementation
+// ---------------------------
+
+TranspositionTable::TranspositionTable() {
+    entries = 0;
+    mask = 0;
+    generation = 0;
+}
+
+void TranspositionTable::init(TTEntry* storage, uint32_t count) {
+    entries = storage;
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    if (entries) memset(entries, 0, (mask + 1) * sizeof(TTEntry));
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = (generation + 1) & 63;
+}
+
+bool TranspositionTable::probe(uint64_t hash, TTEntry &entry) {
+    if (!entries) return false;
+    const TTEntry &slot = entries[(uint32_t)hash & mask];
+    if ((slot.boundAndAge & 3) == 0 || slot.key != (uint32_t)(hash >> 32)) return false;
+    entry = slot;
+    return true;
+}
+
+void TranspositionTable::store(uint64_t hash, Move move, int score, int depth, int bound) {
+    if (!entries) return;
+    TTEntry &slot = entries[(uint32_t)hash & mask];
+    uint32_t key = (uint32_t)(hash >> 32);
+    bool sameSearch = (slot.boundAndAge >> 2) == generation;
+    if (sameSearch && slot.key != key && slot.depth > depth) return;
+
+    // Keep the old best move when this result has none
+    if (move == MOVE_NONE && slot.key == key) move = slot.move;
+    slot.key = key;
+    slot.move = move;
+    slot.score = (int16_t)score;
+    slot.depth = (int8_t)depth;
+    slot.boundAndAge = (uint8_t)((generation << 2) | bound);
+}
+
+int TranspositionTable::hashfull() {
+    if (!entries) return 0;
+    uint32_t sample = mask + 1 < 1000 ? mask + 1 : 1000;
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < sample; i++) {
+        if ((entries[i].boundAndAge & 3) != 0 && (entries[i].boundAndAge >> 2) == generation) used++;
+    }
+    return (int)(used * 1000 / sample);
+}
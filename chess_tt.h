@@ -0,0 +1,51 @@
+#ifndef CHESS_TT_H
+#define CHESS_TT_H
+
+#include <stdint.h>
+#include "chess_position.h"
+
+// ---------------------------
+// Transposition Table Entry
+// ---------------------------
+#define TT_BOUND_UPPER      1   // Score is at most the stored value (failed low)
+#define TT_BOUND_LOWER      2   // Score is at least the stored value (failed high)
+#define TT_BOUND_EXACT      3
+
+struct TTEntry {
+    uint32_t key;           // Upper half of the position hash
+    Move move;
+    int16_t score;
+    int8_t depth;
+    uint8_t boundAndAge;    // Bound in bits 0-1, search generation in bits 2-7
+};
+
+// ---------------------------
+// Transposition Table Class
+// ---------------------------
+// Single-slot hash table over caller-provided storage, so each board can
+// size it to its RAM (or run without one). Entries from older searches are
+// always replaced; within a search deeper results win.
+class TranspositionTable {
+private:
+    TTEntry* entries;
+    uint32_t mask;
+    uint8_t generation;
+
+public:
+    TranspositionTable();
+
+    // count must be a power of two
+    void init(TTEntry* storage, uint32_t count);
+    void clear();
+
+    // Call once per search so stale entries can be told apart
+    void newSearch();
+
+    bool probe(uint64_t hash, TTEntry &entry);
+    void store(uint64_t hash, Move move, int score, int depth, int bound);
+
+    // Permille of sampled entries written by the current search (UCI hashfull)
+    int hashfull();
+};
+
+#endif // CHESS_TT_H
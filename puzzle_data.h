@@ -0,0 +1,139 @@
+#ifndef PUZZLE_DATA_H
+#define PUZZLE_DATA_H
+
+// Generated by tools/puzzle_pack.cpp - rerun the tool instead of editing by hand.
+// Included by puzzle_db.cpp only.
+
+#define PUZZLE_COUNT 89
+
+static const PuzzleBucket PUZZLE_BUCKETS[PUZZLE_BUCKET_COUNT] = {
+    {0, 30},
+    {30, 30},
+    {60, 29},
+    {89, 0},
+    {89, 0},
+};
+
+static const PackedPuzzle PUZZLES[PUZZLE_COUNT > 0 ? PUZZLE_COUNT : 1] = {
+    {{{0xF1,0xE7,0x00,0x18,0x20,0x83,0xB4,0xB7}, {0x53,0x12,0x03,0x00,0x00,0x00,0x41,0x66,0x66,0x66,0x96,0xA7,0x8B,0x09,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 0, 1, 1},  // G10_16
+    {{{0x20,0x02,0x34,0x00,0x88,0x30,0x0B,0x00}, {0x95,0x00,0x63,0x60,0xA8,0xB0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 1, 1, 1},  // G13_79
+    {{{0xCC,0xE1,0x01,0x14,0x1A,0x80,0xA7,0x61}, {0x43,0x35,0x00,0x00,0x00,0x1A,0x70,0x66,0x66,0x66,0xB9,0x09,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 2, 1, 1},  // G18_35
+    {{{0xB5,0xE7,0x00,0x18,0x98,0x01,0xF4,0xFF}, {0x23,0x25,0x03,0x06,0x00,0x00,0x60,0x41,0x66,0x66,0x66,0x79,0xA8,0x8B,0x97,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 800, 3, 1, 1},  // G21_12
+    {{{0x22,0xF4,0x10,0x15,0x00,0x41,0xA4,0x80}, {0x33,0x50,0x00,0x20,0x40,0x60,0x66,0xB6,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 4, 1, 1},  // G25_64
+    {{{0x85,0xAA,0x01,0x60,0x02,0x10,0x95,0xAD}, {0x23,0x03,0x50,0x00,0x01,0x62,0x66,0x67,0x89,0x8B,0x04,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 5, 1, 1},  // G28_38
+    {{{0x04,0x03,0x02,0x55,0x08,0x00,0xE7,0xA7}, {0x35,0xA0,0x00,0x86,0x61,0x26,0x66,0x96,0xB7,0x98,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 0, {0x01,0x00}, {0}}, 800, 6, 1, 1},  // G58_47
+    {{{0x10,0x84,0x16,0x11,0x4C,0x00,0x13,0x20}, {0x05,0x00,0x07,0x60,0x96,0x63,0xB6,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 7, 1, 1},  // G62_69
+    {{{0x81,0xB3,0x00,0x14,0x90,0xC7,0x0C,0x8C}, {0x33,0x00,0x01,0x00,0x60,0x66,0x56,0x26,0x26,0xB9,0x09,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 8, 1, 1},  // G64_42
+    {{{0xB9,0xAB,0x0C,0x90,0x3C,0x80,0x8F,0x91}, {0x43,0x25,0x03,0x10,0x00,0x00,0xA0,0x68,0x86,0x66,0x66,0x67,0xB9,0x09,0x00,0x00}, 0x01, 0x00, 0, {0x01,0x00}, {0}}, 800, 9, 1, 1},  // G71_19
+    {{{0x00,0x00,0x00,0x00,0x20,0x02,0x04,0x01}, {0xAB,0x58,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 10, 1, 1},  // G76_145
+    {{{0x00,0x08,0x01,0x13,0x40,0x80,0x20,0x20}, {0x09,0x05,0xA8,0xB6,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 11, 1, 1},  // G77_99
+    {{{0x02,0x00,0x04,0x00,0x00,0x00,0x02,0x10}, {0x5A,0xBA,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 12, 1, 1},  // G78_161
+    {{{0x45,0x6E,0x90,0x01,0x1D,0x80,0x6A,0xB8}, {0x23,0x03,0x00,0x60,0x05,0x60,0x16,0x66,0x26,0x66,0x74,0x9B,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 13, 1, 1},  // G79_30
+    {{{0x00,0x00,0x05,0x00,0x41,0x11,0x02,0x10}, {0x79,0xA0,0xB6,0x56,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 14, 1, 1},  // G80_105
+    {{{0x00,0x28,0x00,0xA0,0x18,0x80,0x35,0x02}, {0x01,0x09,0x52,0x36,0xB6,0x46,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 15, 1, 1},  // G81_108
+    {{{0x51,0xF3,0x34,0x84,0x42,0x00,0x03,0x18}, {0x53,0x03,0x20,0x00,0x00,0x11,0x66,0x66,0xB6,0x44,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 16, 1, 1},  // G83_60
+    {{{0x00,0x01,0x05,0x00,0x90,0x00,0x00,0x00}, {0x65,0xBA,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 17, 1, 1},  // G84_107
+    {{{0x02,0x00,0x00,0x10,0x20,0x00,0x01,0x00}, {0xB9,0x5A,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 18, 1, 1},  // G85_153
+    {{{0xBD,0xE7,0x0C,0x50,0x00,0x30,0xBF,0xBD}, {0x23,0x54,0x32,0x00,0x00,0x00,0x01,0x10,0x76,0x66,0x66,0x67,0x96,0xA8,0x8B,0x09}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 19, 1, 1},  // G86_12
+    {{{0x95,0xCF,0x04,0x38,0x14,0x04,0xE5,0xD1}, {0x23,0x35,0x00,0x18,0x00,0xA1,0x06,0x08,0x66,0x66,0x66,0xB9,0x97,0x00,0x00,0x00}, 0x01, 0x16, 0, {0x01,0x00}, {0}}, 800, 20, 1, 1},  // G87_25
+    {{{0x40,0x28,0x00,0x40,0x21,0x04,0xAA,0x00}, {0x95,0x09,0x66,0x6A,0x6B,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 0, {0x01,0x00}, {0}}, 800, 21, 1, 1},  // G88_81
+    {{{0x00,0x00,0x2B,0x00,0x00,0x00,0x10,0x80}, {0x00,0x52,0xB4,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 22, 1, 1},  // G89_148
+    {{{0x20,0x00,0x20,0x00,0x00,0x00,0x00,0x08}, {0xB5,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 23, 1, 1},  // G90_175
+    {{{0x00,0x00,0x80,0x04,0x20,0x00,0x10,0x01}, {0x40,0x45,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 24, 1, 1},  // G91_182
+    {{{0x80,0x30,0x00,0x20,0x14,0x06,0x30,0x08}, {0x8A,0x75,0xA7,0x66,0x6B,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 25, 1, 1},  // G92_91
+    {{{0x85,0x29,0x06,0x81,0x04,0x80,0xA7,0x91}, {0x23,0x0A,0x07,0x80,0x08,0x65,0x66,0x66,0x96,0x9B,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 26, 1, 1},  // G93_39
+    {{{0x40,0x05,0x01,0x80,0x40,0x0C,0x40,0x10}, {0x03,0x60,0x05,0x42,0x4B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 27, 1, 1},  // G94_114
+    {{{0x00,0x10,0x48,0x02,0x00,0x04,0x00,0x08}, {0x53,0x00,0xB4,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 800, 28, 1, 1},  // G95_94
+    {{{0x22,0xB4,0x41,0x28,0x61,0x0D,0xF6,0x48}, {0x53,0x40,0x00,0x00,0x20,0x86,0x91,0x6A,0x66,0x68,0x66,0x9B,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 800, 29, 1, 1},  // G96_51
+    {{{0x00,0x61,0x88,0x40,0x04,0x10,0x23,0x00}, {0x30,0x97,0x50,0xB6,0x66,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 30, 2, 3},  // G3_89
+    {{{0x81,0x89,0x04,0x8C,0x88,0xE0,0x45,0xC2}, {0x33,0x50,0x20,0x02,0x00,0x60,0x64,0x66,0x96,0x9B,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 33, 2, 3},  // G12_50
+    {{{0x82,0xB5,0x10,0x40,0x11,0x00,0x0C,0x41}, {0x33,0x00,0x05,0x20,0x66,0x64,0x9B,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 36, 2, 3},  // G14_52
+    {{{0x40,0xA0,0x00,0x00,0x42,0x02,0x00,0x00}, {0xB9,0x05,0x66,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 39, 2, 3},  // G16_119
+    {{{0xD5,0xA7,0x04,0x1C,0x10,0x24,0xE7,0xA7}, {0x23,0x15,0x03,0x00,0x00,0x61,0x60,0xB6,0x6A,0x66,0x64,0x96,0x87,0x98,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1150, 42, 2, 3},  // G17_18
+    {{{0x80,0x00,0x20,0x00,0x00,0x41,0x04,0x10}, {0x7A,0x96,0xB5,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 45, 2, 3},  // G27_131
+    {{{0xD2,0xC3,0x05,0x38,0x0A,0x02,0xE5,0xE5}, {0x53,0x31,0x07,0x00,0x01,0x60,0x24,0x6B,0xA6,0x66,0x96,0x88,0x97,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 48, 2, 3},  // G30_24
+    {{{0x20,0x05,0x45,0x80,0x00,0x48,0x40,0x00}, {0x05,0x60,0x06,0x33,0xB0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1150, 51, 2, 3},  // G37_94
+    {{{0x00,0x62,0x21,0x80,0x1B,0x86,0x04,0x10}, {0x00,0x00,0x03,0x06,0x15,0x06,0x66,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1150, 54, 2, 3},  // G44_74
+    {{{0xD1,0x46,0xB1,0x09,0x0A,0x20,0x9D,0xA1}, {0x53,0x31,0x00,0x0A,0x06,0x10,0x64,0x66,0x66,0xB8,0x26,0x98,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 57, 2, 3},  // G45_27
+    {{{0x00,0x00,0x0C,0xF0,0x04,0x00,0xF0,0x08}, {0x30,0x50,0xA0,0xB9,0x66,0x96,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 60, 2, 3},  // G47_93
+    {{{0x01,0x95,0x20,0x00,0x4C,0x1C,0x67,0x84}, {0x0A,0x50,0x00,0x10,0x76,0xB7,0x66,0x64,0x86,0x09,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 0, {0x01,0x00}, {0}}, 1150, 63, 2, 3},  // G49_49
+    {{{0x82,0xE5,0x04,0x90,0x80,0x01,0x24,0x00}, {0x33,0x00,0x00,0xB0,0x85,0x26,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 66, 2, 3},  // G50_54
+    {{{0x94,0x44,0x81,0x08,0x63,0x04,0xD6,0x44}, {0x53,0x03,0x00,0x60,0x26,0x14,0x67,0xB6,0x66,0x99,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 69, 2, 3},  // G52_46
+    {{{0x00,0x00,0x00,0x40,0x10,0x00,0x80,0x00}, {0xBA,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 72, 2, 3},  // G53_141
+    {{{0x10,0x24,0x08,0x04,0x02,0x82,0x00,0x04}, {0x05,0x43,0x16,0x16,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1150, 75, 2, 3},  // G54_92
+    {{{0x08,0x21,0x50,0x16,0x45,0x10,0xE8,0x81}, {0x05,0x0A,0x00,0x60,0x66,0xB0,0x68,0x66,0x99,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 78, 2, 3},  // G55_51
+    {{{0x05,0x51,0x82,0x10,0x02,0x1E,0xE1,0x8A}, {0xAA,0x50,0x00,0x00,0x61,0x87,0x68,0x63,0x96,0x9B,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 81, 2, 3},  // G56_45
+    {{{0x20,0x05,0x50,0x30,0x09,0xC0,0x40,0x02}, {0x03,0x50,0x10,0x60,0xB4,0x66,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 84, 2, 3},  // G57_82
+    {{{0x00,0x00,0x00,0x00,0x90,0x00,0x00,0x40}, {0x45,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 87, 2, 3},  // G59_146
+    {{{0x20,0x00,0x00,0x50,0x00,0x00,0x00,0x00}, {0xB5,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 90, 2, 3},  // G60_127
+    {{{0x00,0xE4,0x11,0x40,0x10,0x86,0xB1,0x98}, {0x00,0x03,0x50,0x08,0x66,0x66,0x67,0x96,0x9B,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 93, 2, 3},  // G61_47
+    {{{0x80,0x20,0xA2,0x41,0x25,0x02,0x60,0x80}, {0x35,0x7A,0x00,0x66,0xB8,0x66,0x96,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 96, 2, 3},  // G63_77
+    {{{0x88,0x66,0x83,0x10,0x2A,0x27,0x84,0xA0}, {0x33,0x00,0x05,0x40,0x60,0x26,0x66,0x89,0x62,0xB6,0x09,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 99, 2, 3},  // G65_56
+    {{{0x02,0x00,0x00,0xA4,0xA0,0x14,0x44,0x00}, {0x6A,0x05,0x06,0xB6,0x86,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 102, 2, 3},  // G67_103
+    {{{0x20,0x00,0x20,0x08,0x00,0x10,0x00,0x00}, {0x85,0xBA,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 105, 2, 3},  // G69_129
+    {{{0x40,0x02,0x24,0x28,0x00,0x00,0x21,0x80}, {0x03,0x25,0x23,0xB0,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 108, 2, 3},  // G70_116
+    {{{0x04,0x40,0x00,0x90,0xA1,0x50,0x00,0x08}, {0x03,0x06,0x56,0x46,0xB6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1150, 111, 2, 3},  // G72_94
+    {{{0x00,0x60,0x04,0x80,0x48,0x24,0xA4,0x00}, {0x00,0x06,0x64,0xB5,0x62,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1150, 114, 2, 3},  // G73_78
+    {{{0x02,0xE7,0xB0,0x97,0x84,0x49,0x8A,0x19}, {0x03,0x00,0x00,0x23,0x15,0x71,0x02,0x60,0x66,0x76,0x86,0x96,0xBA,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1150, 117, 2, 3},  // G75_39
+    {{{0x00,0x84,0x01,0x50,0x87,0x20,0x08,0x00}, {0x00,0x20,0x66,0xB6,0x50,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1500, 120, 3, 5},  // G0_84
+    {{{0x00,0x51,0x9A,0x00,0x52,0xC0,0x22,0x00}, {0x50,0x00,0x60,0x60,0x6B,0x63,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1500, 125, 3, 5},  // G1_68
+    {{{0xA0,0x30,0x9A,0x08,0x48,0x05,0x87,0x00}, {0x35,0x02,0x80,0x00,0x60,0xB9,0x66,0x46,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 130, 3, 5},  // G2_68
+    {{{0x00,0xA1,0x40,0x80,0x40,0x16,0x05,0x80}, {0x60,0x05,0x81,0xB6,0x60,0x96,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 135, 3, 5},  // G4_83
+    {{{0x91,0x97,0x30,0x40,0x58,0xC0,0x47,0x93}, {0x83,0x03,0x00,0x05,0x00,0x60,0x16,0x66,0x66,0x46,0x79,0x9B,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1500, 140, 3, 5},  // G5_34
+    {{{0x22,0xE4,0x54,0x08,0x11,0x80,0x24,0x04}, {0x33,0x00,0x0B,0x50,0x00,0x66,0x66,0x84,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 145, 3, 5},  // G6_54
+    {{{0x02,0x03,0x40,0x68,0x84,0x9A,0x92,0x81}, {0x7A,0x50,0x08,0x60,0x60,0xB6,0x86,0x67,0x99,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 150, 3, 5},  // G7_65
+    {{{0x02,0x10,0x25,0x50,0x00,0x40,0x0C,0x14}, {0x9A,0x00,0x00,0x65,0x66,0xB8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 155, 3, 5},  // G8_67
+    {{{0xDD,0xA7,0x04,0x10,0x06,0x10,0xF7,0x87}, {0x23,0x54,0x31,0x00,0x00,0x10,0x20,0x6B,0x66,0x86,0x66,0x96,0x87,0x09,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 160, 3, 5},  // G9_18
+    {{{0x00,0x00,0x00,0x12,0x40,0x08,0x04,0x00}, {0xB9,0xA5,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 165, 3, 5},  // G11_143
+    {{{0x97,0xEF,0x80,0x18,0x04,0x20,0xBD,0xB1}, {0x13,0x52,0x03,0x00,0x00,0x00,0x71,0x40,0x67,0x66,0x66,0xA6,0x8B,0x09,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 170, 3, 5},  // G19_17
+    {{{0xE1,0xE3,0x00,0x1C,0x45,0x24,0x94,0x0A}, {0x53,0x31,0x00,0x00,0x20,0x64,0x16,0x92,0x66,0x6B,0x97,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1500, 175, 3, 5},  // G20_34
+    {{{0x80,0x08,0x00,0x01,0x05,0x01,0x20,0x80}, {0x53,0x60,0x26,0x4B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 180, 3, 5},  // G22_106
+    {{{0x10,0x31,0x04,0x00,0x85,0x00,0x00,0x00}, {0x03,0xB6,0x05,0x46,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 185, 3, 5},  // G23_116
+    {{{0x93,0xE7,0x28,0x00,0x40,0x12,0xED,0xA1}, {0x13,0x35,0x00,0x00,0x00,0x12,0x72,0x6B,0x74,0x66,0x96,0x98,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 190, 3, 5},  // G24_26
+    {{{0x00,0x20,0xA1,0x2C,0x81,0x24,0x42,0x08}, {0x00,0x05,0x00,0x60,0x66,0x3B,0x93,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 0, {0x02,0x00}, {0}}, 1500, 195, 3, 5},  // G26_82
+    {{{0x03,0x65,0x80,0x00,0x81,0x10,0x02,0x08}, {0x53,0x30,0x00,0x60,0x4B,0x92,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 200, 3, 5},  // G31_72
+    {{{0x85,0xEF,0x14,0x08,0x14,0x03,0xFF,0xC0}, {0x23,0x03,0x00,0x05,0x00,0x01,0x84,0x61,0x96,0x6A,0xB8,0x62,0x76,0x09,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 205, 3, 5},  // G32_28
+    {{{0x28,0x02,0x02,0x20,0x25,0x01,0x21,0x00}, {0x53,0x99,0x08,0x6B,0x66,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 210, 3, 5},  // G33_73
+    {{{0x40,0x00,0xC8,0x11,0x43,0x01,0x08,0x00}, {0x11,0x00,0xA0,0x66,0x95,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 215, 3, 5},  // G34_97
+    {{{0x00,0x26,0x10,0x01,0x20,0x40,0x00,0x00}, {0x05,0x49,0xB0,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 220, 3, 5},  // G35_96
+    {{{0x01,0x02,0x05,0x10,0x30,0x8A,0x86,0x00}, {0x59,0x09,0x67,0x66,0x6B,0x66,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 0, {0x01,0x00}, {0}}, 1500, 225, 3, 5},  // G36_65
+    {{{0x24,0x4A,0x80,0xA8,0x03,0x44,0x81,0x02}, {0x53,0x80,0x40,0x00,0x00,0x66,0x66,0xB6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x2A, 0, {0x02,0x00}, {0}}, 1500, 230, 3, 5},  // G38_68
+    {{{0x91,0xF5,0x01,0x00,0x52,0x00,0xC0,0x65}, {0x53,0x03,0x10,0x00,0x00,0x06,0x61,0x46,0xB7,0x09,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 235, 3, 5},  // G40_32
+    {{{0x00,0x20,0x20,0x20,0x10,0x00,0x28,0x00}, {0x05,0x46,0xB0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 240, 3, 5},  // G41_116
+    {{{0x04,0x08,0x40,0x12,0x24,0x81,0x04,0x04}, {0x53,0x99,0x08,0x36,0x66,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 245, 3, 5},  // G42_89
+    {{{0x80,0x97,0x00,0x90,0x90,0x60,0x84,0x61}, {0x03,0x06,0x51,0x00,0x66,0x64,0x96,0x82,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x00, 0x00, 1, {0x02,0x00}, {0}}, 1500, 250, 3, 5},  // G43_64
+    {{{0x04,0x10,0x00,0x10,0x91,0x06,0x04,0x00}, {0x5A,0x60,0x06,0xB9,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 255, 3, 5},  // G46_89
+    {{{0x00,0x00,0x12,0x08,0x08,0x50,0x00,0x00}, {0xAB,0x96,0x54,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, 0x01, 0x00, 1, {0x01,0x00}, {0}}, 1500, 260, 3, 5},  // G48_157
+};
+
+static const Move PUZZLE_SOLUTIONS[265] = {
+    0x0EA5, 0x0030, 0x039C, 0x0D67, 0x0D5A, 0x0F7F, 0x00D1, 0x00E3, 0x09AF, 0x035F,
+    0x0E69, 0x029C, 0x0671, 0x0F3B, 0x0FA6, 0x0CB0, 0x087C, 0x0252, 0x0825, 0x0B5E,
+    0x035B, 0x00AA, 0x0DF4, 0x00FB, 0x0E9A, 0x05DD, 0x0A87, 0x0CEB, 0x0F0C, 0x01EA,
+    0x0DB5, 0x09DE, 0x05D3, 0x0AE3, 0x0F7E, 0x0D6E, 0x00C7, 0x0EB3, 0x0B24, 0x0586,
+    0x01CF, 0x05D6, 0x08F5, 0x0A6A, 0x0863, 0x0047, 0x0EB2, 0x0AAE, 0x0C9D, 0x0648,
+    0x06A1, 0x0DDF, 0x0FB6, 0x0EEB, 0x0BA4, 0x0620, 0x0F55, 0x034E, 0x00C4, 0x014D,
+    0x035F, 0x0553, 0x09B6, 0x03FF, 0x050C, 0x06C0, 0x4EB2, 0x02D2, 0x00C1, 0x0B25,
+    0x0F74, 0x0147, 0x0B64, 0x0FF7, 0x0D9E, 0x08D3, 0x049A, 0x0F4D, 0x0633, 0x0083,
+    0x028D, 0x0102, 0x054C, 0x00C0, 0x095D, 0x0DEE, 0x0FA3, 0x0B64, 0x0F7E, 0x0FE7,
+    0x051C, 0x0105, 0x019E, 0x0974, 0x0714, 0x06FB, 0x0051, 0x0387, 0x0181, 0x0651,
+    0x0F3D, 0x0D19, 0x0441, 0x099D, 0x0591, 0x02DB, 0x0185, 0x038B, 0x0ADB, 0x0D35,
+    0x0D86, 0x0B65, 0x051C, 0x0E82, 0x0923, 0x0BAD, 0x09A4, 0x07B3, 0x0595, 0x07FB,
+    0x092D, 0x0A62, 0x0C73, 0x08A9, 0x0CB1, 0x4F75, 0x0661, 0x0AEE, 0x07A6, 0x0B7D,
+    0x04CC, 0x0871, 0x0AB2, 0x0828, 0x086A, 0x414D, 0x0408, 0x07FF, 0x07D6, 0x0766,
+    0x0D76, 0x0EFC, 0x0B26, 0x0EBB, 0x0CB5, 0x0185, 0x03CE, 0x01C6, 0x038F, 0x0181,
+    0x0181, 0x05D6, 0x0386, 0x07D7, 0x03CE, 0x0081, 0x0610, 0x038C, 0x07DE, 0x01C2,
+    0x0502, 0x0662, 0x06C3, 0x0819, 0x061B, 0x055C, 0x09E6, 0x0755, 0x07E7, 0x0BEB,
+    0x0738, 0x0144, 0x031C, 0x0185, 0x010C, 0x091B, 0x0B2A, 0x0B24, 0x0F74, 0x0BE6,
+    0x0BC7, 0x06A2, 0x0B7F, 0x0FB5, 0x06A8, 0x07A7, 0x06A2, 0x0304, 0x014D, 0x039E,
+    0x06D5, 0x08EC, 0x0481, 0x06E3, 0x0526, 0x0D71, 0x0B2D, 0x095D, 0x0AEC, 0x0B75,
+    0x088A, 0x08FB, 0x08E2, 0x07E7, 0x058E, 0x0CDB, 0x0B74, 0x07A4, 0x09AD, 0x07CF,
+    0x0551, 0x0185, 0x051D, 0x01C6, 0x05D5, 0x0BA8, 0x09E6, 0x095C, 0x07E7, 0x09A5,
+    0x0B14, 0x0765, 0x07AE, 0x055D, 0x072C, 0x0210, 0x0449, 0x02DC, 0x0651, 0x0040,
+    0x0A82, 0x0A30, 0x0CD7, 0x050B, 0x0EAA, 0x0578, 0x0F3D, 0x0D55, 0x0EFC, 0x0B26,
+    0x4EF3, 0x0BB5, 0x09A4, 0x0DEE, 0x0FBB, 0x0259, 0x0282, 0x0289, 0x00CB, 0x0196,
+    0x08F8, 0x0D77, 0x0D6D, 0x0FFE, 0x0FB5, 0x0469, 0x034C, 0x0282, 0x014D, 0x0051,
+    0x0B14, 0x0DAE, 0x0CE3, 0x0FF6, 0x0F2C,
+};
+
+#endif // PUZZLE_DATA_H
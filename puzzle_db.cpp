@@ -0,0 +1,33 @@
+#include "puzzle_db.h"
+#include "puzzle_data.h"
+
+// ---------------------------
+// PuzzleDB Implementation
+// ---------------------------
+
+PuzzleDB::PuzzleDB(const ChessEngine* ce) : engine(ce) {
+}
+
+int PuzzleDB::count() {
+    return PUZZLE_COUNT;
+}
+
+int PuzzleDB::bucketSize(int bucket) {
+    if (bucket < 0 || bucket >= PUZZLE_BUCKET_COUNT) return 0;
+    return PUZZLE_BUCKETS[bucket].count;
+}
+
+bool PuzzleDB::load(int bucket, int index, Puzzle &puzzle) {
+    if (index < 0 || index >= bucketSize(bucket)) return false;
+    const PackedPuzzle &packed = PUZZLES[PUZZLE_BUCKETS[bucket].first + index];
+
+    if (!engine->unpackPosition(packed.position, puzzle.pos)) return false;
+    puzzle.rating = packed.rating;
+    puzzle.mateIn = packed.mateIn;
+    puzzle.solutionLength = packed.solutionLength;
+    if (puzzle.solutionLength > PUZZLE_MAX_PLIES) puzzle.solutionLength = PUZZLE_MAX_PLIES;
+    for (int i = 0; i < puzzle.solutionLength; i++) {
+        puzzle.solution[i] = PUZZLE_SOLUTIONS[packed.solutionStart + i];
+    }
+    return true;
+}
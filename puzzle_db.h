@@ -0,0 +1,68 @@
+#ifndef PUZZLE_DB_H
+#define PUZZLE_DB_H
+
+#include <stdint.h>
+#include "chess_engine.h"
+#include "chess_mate.h"
+
+// ---------------------------
+// Puzzle Database Configuration
+// ---------------------------
+#define PUZZLE_BUCKET_COUNT     5       // Rating buckets: <1000, <1400, <1800, <2200, 2200+
+#define PUZZLE_BUCKET_BASE      600
+#define PUZZLE_BUCKET_WIDTH     400
+#define PUZZLE_MAX_PLIES        (2 * MATE_MAX_MOVES - 1)
+
+// One puzzle as stored in flash (38 bytes): the position in the engine's
+// packed form, and its solution as a run of 16-bit moves in
+// PUZZLE_SOLUTIONS, attacker first
+struct PackedPuzzle {
+    PackedPosition position;
+    uint16_t rating;
+    uint16_t solutionStart;
+    uint8_t mateIn;             // In attacker moves
+    uint8_t solutionLength;     // In plies
+};
+
+// Puzzles of each bucket are stored together, so a random puzzle of a
+// given strength is one table lookup away
+struct PuzzleBucket {
+    uint16_t first;
+    uint16_t count;
+};
+
+// A puzzle unpacked for play
+struct Puzzle {
+    Position pos;
+    int rating;
+    int mateIn;
+    int solutionLength;
+    Move solution[PUZZLE_MAX_PLIES];
+};
+
+// ---------------------------
+// Puzzle Database Class
+// ---------------------------
+// Read access to the compiled-in set (puzzle_data.h, generated by
+// tools/puzzle_pack.cpp). The tables are const, so boards with memory-
+// mapped flash (ESP32, RP2040, SAMD) read them in place.
+class PuzzleDB {
+private:
+    const ChessEngine* engine;
+
+public:
+    PuzzleDB(const ChessEngine* ce);
+
+    static int bucketFor(int rating) {
+        int bucket = (rating - PUZZLE_BUCKET_BASE) / PUZZLE_BUCKET_WIDTH;
+        if (bucket < 0) return 0;
+        return bucket < PUZZLE_BUCKET_COUNT ? bucket : PUZZLE_BUCKET_COUNT - 1;
+    }
+    int count();
+    int bucketSize(int bucket);
+
+    // Unpack puzzle index of a bucket; false if out of range
+    bool load(int bucket, int index, Puzzle &puzzle);
+};
+
+#endif // PUZZLE_DB_H
@@ -22,6 +22,10 @@ void SensorTest::begin() {
     Serial.println("Place pieces on the board to see them light up!");
     Serial.println("This mode continuously displays detected pieces.");
     
+    // Tune the row timing to whatever is on the board right now
+    Serial.println("Calibrating sensor timing - keep the pieces still...");
+    boardDriver->calibrateSettleTime();
+    
     boardDriver->clearAllLEDs();
 }
 
@@ -1,18 +1,26 @@
 #ifndef STOCKFISH_SETTINGS_H
 #define STOCKFISH_SETTINGS_H
 
+#include <stdint.h>
+
 // Stockfish Engine Settings
 struct StockfishSettings {
     int depth = 12;                    // Search depth (1-15, higher = stronger but slower)
     int timeoutMs = 30000;             // API timeout in milliseconds (30 seconds)
     bool useBook = true;               // Use opening book for first moves
     int maxRetries = 3;                // Max API call retries on failure
+    int localMoveTimeMs = 2000;        // On-board engine latency cap, used when the API is unreachable
+    uint32_t localNodes = 100000;      // On-board engine node budget; sets strength and cost
+    int localEvalNoise = 0;            // On-board engine eval noise in centipawns (weakens play)
     
     // Difficulty presets
     static StockfishSettings easy() {
         StockfishSettings s;
         s.depth = 6;
         s.timeoutMs = 15000;
+        s.localMoveTimeMs = 300;
+        s.localNodes = 5000;
+        s.localEvalNoise = 60;
         return s;
     }
     
@@ -20,6 +28,9 @@ struct StockfishSettings {
         StockfishSettings s;
         s.depth = 6;
         s.timeoutMs = 25000;
+        s.localMoveTimeMs = 1000;
+        s.localNodes = 25000;
+        s.localEvalNoise = 25;
         return s;
     }
     
@@ -27,6 +38,9 @@ struct StockfishSettings {
         StockfishSettings s;
         s.depth = 14;
         s.timeoutMs = 45000;
+        s.localMoveTimeMs = 2500;
+        s.localNodes = 100000;
+        s.localEvalNoise = 0;
         return s;
     }
     
@@ -34,6 +48,9 @@ struct StockfishSettings {
         StockfishSettings s;
         s.depth = 16;
         s.timeoutMs = 60000;
+        s.localMoveTimeMs = 5000;
+        s.localNodes = 400000;
+        s.localEvalNoise = 0;
         return s;
     }
 };
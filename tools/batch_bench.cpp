@@ -0,0 +1,124 @@
+// Batch move-validation benchmark
+//
+// Builds a batch of (position, move) queries from random games, half of
+// them legal moves and half random moves of the side to move, checks the
+// bitmap against full legal move generation, then reports validations per
+// second at 1, 4 and 16 threads.
+//
+// Build on a Linux host from the repository root (one command):
+//   g++ -O3 -march=native -std=c++17 -pthread -I. tools/batch_bench.cpp
+//       chess_batch.cpp chess_context.cpp chess_engine.cpp chess_history.cpp
+//       -o batch_bench
+//
+// Usage:
+//   ./batch_bench [queries] [rounds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "chess_batch.h"
+#include "chess_context.h"
+
+#define BENCH_GAME_PLIES    80
+
+static uint64_t randomState = 0x2545F4914F6CDD1DULL;
+
+static uint32_t nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return (uint32_t)(randomState >> 32);
+}
+
+// A random move by a piece of the side to move, legal or not
+static Move randomMove(const Position &pos) {
+    for (;;) {
+        int from = nextRandom() & 63;
+        char piece = pos.board[from >> 3][from & 7];
+        if (piece == ' ' || (piece < 'a') != pos.whiteToMove) continue;
+        int to = nextRandom() & 63;
+        bool lastRank = (piece == 'P' && (to >> 3) == 7) || (piece == 'p' && (to >> 3) == 0);
+        return encodeMove(from, to, lastRank ? PROMOTE_QUEEN : PROMOTE_NONE);
+    }
+}
+
+static void buildQueries(const ChessEngine &engine, std::vector<MoveQuery> &queries, int count) {
+    GameContext game(&engine);
+    int ply = BENCH_GAME_PLIES;
+    for (int i = 0; i < count; i++) {
+        Move legal[MAX_MOVES];
+        int legalCount = game.legalMoves(legal);
+        if (legalCount == 0 || ply >= BENCH_GAME_PLIES) {
+            game.setStartPosition();
+            ply = 0;
+            legalCount = game.legalMoves(legal);
+        }
+
+        MoveQuery &query = queries[i];
+        memcpy(query.board, game.pos.board, sizeof(query.board));
+        query.whiteToMove = game.pos.whiteToMove;
+        query.castling = game.pos.castling;
+        query.epSquare = game.pos.epSquare;
+        query.move = (i & 1) ? randomMove(game.pos) : legal[nextRandom() % legalCount];
+
+        // Advance the game every other query so pairs share a position
+        if (i & 1) {
+            game.playMove(legal[nextRandom() % legalCount]);
+            ply++;
+        }
+    }
+}
+
+// Reference answer from full legal move generation
+static bool checkBitmap(const ChessEngine &engine, const std::vector<MoveQuery> &queries,
+                        const std::vector<uint32_t> &bitmap) {
+    for (size_t i = 0; i < queries.size(); i++) {
+        Position pos;
+        engine.setupPosition(pos, queries[i].board, queries[i].whiteToMove);
+        pos.castling = queries[i].castling;
+        pos.epSquare = queries[i].epSquare;
+        Move legal[MAX_MOVES];
+        int count = engine.generateLegalMoves(pos, legal);
+        bool expected = false;
+        for (int j = 0; j < count; j++) expected |= (legal[j] == queries[i].move);
+        if (BatchValidator::isValid(bitmap.data(), i) != expected) {
+            fprintf(stderr, "Query %zu: bitmap says %d, move generation says %d\n",
+                    i, !expected, expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 1 << 18;
+    int rounds = argc > 2 ? atoi(argv[2]) : 5;
+
+    ChessEngine engine;
+    BatchValidator validator(&engine);
+    std::vector<MoveQuery> queries(count);
+    std::vector<uint32_t> bitmap((count + 31) / 32);
+    buildQueries(engine, queries, count);
+
+    validator.validateParallel(queries.data(), count, bitmap.data(), 4);
+    if (!checkBitmap(engine, queries, bitmap)) return 1;
+    int legal = 0;
+    for (int i = 0; i < count; i++) legal += BatchValidator::isValid(bitmap.data(), i);
+    printf("%d queries (%zu bytes each), %d legal\n", count, sizeof(MoveQuery), legal);
+
+    static const int THREAD_COUNTS[] = {1, 4, 16};
+    for (int t = 0; t < 3; t++) {
+        int threads = THREAD_COUNTS[t];
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            validator.validateParallel(queries.data(), count, bitmap.data(), threads);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("%2d threads: %12.0f validations/sec\n", threads, (double)count * rounds / seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+// Text codec microbenchmark
+//
+// Times the fixed-buffer codecs the bot uses on every move (FEN out and
+// in, UCI move text out and in, URL encoding of a FEN) on positions from
+// random games, after checking that each one round-trips. For comparison
+// it also times FEN building and URL encoding by appending one character
+// at a time to a std::string, which is how the bot used to build its
+// Arduino Strings.
+//
+// Build on a Linux host from the repository root (one command):
+//   g++ -O2 -std=c++17 -I. tools/codec_bench.cpp chess_codec.cpp
+//       chess_context.cpp chess_engine.cpp chess_history.cpp -o codec_bench
+//
+// Usage:
+//   ./codec_bench [positions] [rounds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "chess_codec.h"
+#include "chess_context.h"
+
+#define BENCH_GAME_PLIES    100
+
+struct Sample {
+    Position pos;
+    Move move;
+    char fen[FEN_MAX_LENGTH];
+    char moveText[MOVE_TEXT_SIZE];
+};
+
+static uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return (uint32_t)(randomState >> 32);
+}
+
+static void buildSamples(const ChessEngine &engine, std::vector<Sample> &samples) {
+    GameContext game(&engine);
+    int ply = 0;
+    for (size_t i = 0; i < samples.size(); i++) {
+        Move legal[MAX_MOVES];
+        int count = game.legalMoves(legal);
+        if (count == 0 || ply >= BENCH_GAME_PLIES) {
+            game.setStartPosition();
+            ply = 0;
+            count = game.legalMoves(legal);
+        }
+        Sample &sample = samples[i];
+        sample.pos = game.pos;
+        sample.move = legal[nextRandom() % count];
+        engine.formatFEN(sample.pos, sample.fen);
+        formatUciMove(sample.move, sample.moveText);
+        game.playMove(sample.move);
+        ply++;
+    }
+}
+
+static bool checkRoundTrips(const ChessEngine &engine, const std::vector<Sample> &samples) {
+    for (size_t i = 0; i < samples.size(); i++) {
+        const Sample &sample = samples[i];
+        Position parsed;
+        char fen[FEN_MAX_LENGTH];
+        if (!engine.setupPositionFromFEN(parsed, sample.fen)) return false;
+        engine.formatFEN(parsed, fen);
+        if (strcmp(fen, sample.fen) != 0 || parsed.hash != sample.pos.hash) return false;
+        if (parseUciMove(sample.moveText, (int)strlen(sample.moveText)) != sample.move) return false;
+    }
+    return true;
+}
+
+// The old way: one String append per character
+static std::string appendFEN(const Position &pos) {
+    std::string fen = "";
+    for (int row = 7; row >= 0; row--) {
+        int empty = 0;
+        for (int col = 0; col < 8; col++) {
+            char piece = pos.board[row][col];
+            if (piece == ' ') {
+                empty++;
+                continue;
+            }
+            if (empty > 0) fen += std::to_string(empty);
+            empty = 0;
+            fen += piece;
+        }
+        if (empty > 0) fen += std::to_string(empty);
+        if (row > 0) fen += "/";
+    }
+    fen += pos.whiteToMove ? " w" : " b";
+    fen += " KQkq - 0 1";
+    return fen;
+}
+
+static std::string appendUrlEncode(const char* text) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    std::string encoded = "";
+    for (; *text != '\0'; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (isalnum(c)) {
+            encoded += (char)c;
+        } else {
+            encoded += '%';
+            encoded += HEX_DIGITS[c >> 4];
+            encoded += HEX_DIGITS[c & 15];
+        }
+    }
+    return encoded;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static void report(const char* name, Clock::time_point start, size_t conversions, uint64_t checksum) {
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    printf("  %-28s %8.1f ns   (checksum %llu)\n", name, ns / conversions, (unsigned long long)checksum);
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 10000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+    if (count <= 0 || rounds <= 0) {
+        fprintf(stderr, "usage: %s [positions] [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    ChessEngine engine;
+    std::vector<Sample> samples(count);
+    buildSamples(engine, samples);
+    if (!checkRoundTrips(engine, samples)) {
+        printf("round trip MISMATCH\n");
+        return 1;
+    }
+    printf("%d positions, %d rounds, round trips ok\n", count, rounds);
+    size_t conversions = (size_t)count * rounds;
+
+    uint64_t checksum = 0;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        char fen[FEN_MAX_LENGTH];
+        for (int i = 0; i < count; i++) checksum += engine.formatFEN(samples[i].pos, fen);
+    }
+    report("formatFEN", start, conversions, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        Position parsed;
+        for (int i = 0; i < count; i++) {
+            engine.setupPositionFromFEN(parsed, samples[i].fen);
+            checksum += parsed.hash & 0xFFFF;
+        }
+    }
+    report("setupPositionFromFEN", start, conversions, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        char text[MOVE_TEXT_SIZE];
+        for (int i = 0; i < count; i++) checksum += formatUciMove(samples[i].move, text) + text[2];
+    }
+    report("formatUciMove", start, conversions, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) {
+            const char* text = samples[i].moveText;
+            checksum += parseUciMove(text, text[4] ? 5 : 4);
+        }
+    }
+    report("parseUciMove", start, conversions, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        char encoded[URL_ENCODED_SIZE(FEN_MAX_LENGTH)];
+        for (int i = 0; i < count; i++) checksum += urlEncode(samples[i].fen, encoded, sizeof(encoded));
+    }
+    report("urlEncode (FEN)", start, conversions, checksum);
+
+    printf("Appending to a string, for comparison:\n");
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) checksum += appendFEN(samples[i].pos).size();
+    }
+    report("FEN by +=", start, conversions, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) checksum += appendUrlEncode(samples[i].fen).size();
+    }
+    report("urlEncode by +=", start, conversions, checksum);
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Plays the on-board engine's difficulty levels against each other
+//
+// Levels are defined by node budgets and eval noise (stockfish_settings.h)
+// with no time limit, so every game here replays exactly and the score of a
+// match is a reproducible strength calibration.
+//
+// Build on a Linux host from the repository root (one command):
+//   g++ -O2 -std=c++17 -I. tools/level_match.cpp chess_engine.cpp
+//       chess_eval.cpp chess_search.cpp chess_history.cpp chess_nnue.cpp
+//       chess_time.cpp chess_tt.cpp chess_context.cpp -o level_match
+//
+// Usage:
+//   ./level_match <white level 1-4> <black level 1-4> [games]
+// Colours alternate every game. Each pair of games opens with the same two
+// plies, picked from the game number, so the pairs differ.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "chess_context.h"
+#include "chess_search.h"
+#include "stockfish_settings.h"
+
+#define MATCH_MAX_PLIES     300
+
+static StockfishSettings levelSettings(int level) {
+    switch (level) {
+        case 1: return StockfishSettings::easy();
+        case 2: return StockfishSettings::medium();
+        case 3: return StockfishSettings::hard();
+        default: return StockfishSettings::expert();
+    }
+}
+
+static SearchLimits levelLimits(int level) {
+    StockfishSettings settings = levelSettings(level);
+    SearchLimits limits;
+    limits.nodeLimit = settings.localNodes;
+    limits.evalNoise = settings.localEvalNoise;
+    return limits;
+}
+
+// Returns 1 if White wins, -1 if Black wins, 0 for a draw
+static int playGame(GameContext &game, ChessSearch &search, int whiteLevel, int blackLevel,
+                    int gameIndex, uint64_t &nodes, int &moves) {
+    game.setStartPosition();
+
+    for (int ply = 0; ply < MATCH_MAX_PLIES; ply++) {
+        Move legal[MAX_MOVES];
+        int count = game.legalMoves(legal);
+        if (count == 0) {
+            if (!game.isInCheck()) return 0;
+            return game.pos.whiteToMove ? -1 : 1;
+        }
+        if (game.isDraw()) return 0;
+
+        Move move;
+        if (ply < 2) {
+            move = legal[(gameIndex / 2 * 7 + ply * 3) % count];
+        } else {
+            int score;
+            SearchLimits limits = levelLimits(game.pos.whiteToMove ? whiteLevel : blackLevel);
+            move = search.findBestMove(game, limits, score);
+            nodes += search.getNodes();
+            moves++;
+        }
+        game.playMove(move);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <white level 1-4> <black level 1-4> [games]\n", argv[0]);
+        return 1;
+    }
+    int levelA = atoi(argv[1]);
+    int levelB = atoi(argv[2]);
+    int games = argc > 3 ? atoi(argv[3]) : 20;
+
+    ChessEngine engine;
+    GameContext* context = new GameContext(&engine);
+    ChessSearch* search = new ChessSearch(&engine);
+    int wins = 0, draws = 0, losses = 0;
+    uint64_t nodes = 0;
+    int moves = 0;
+
+    for (int game = 0; game < games; game++) {
+        bool swapped = (game & 1) != 0;
+        int result = swapped ? -playGame(*context, *search, levelB, levelA, game, nodes, moves)
+                             : playGame(*context, *search, levelA, levelB, game, nodes, moves);
+        if (result > 0) wins++;
+        else if (result < 0) losses++;
+        else draws++;
+        printf("Game %d: %s\n", game + 1, result > 0 ? "level A wins" : result < 0 ? "level B wins" : "draw");
+    }
+
+    printf("Level %d vs level %d: +%d =%d -%d (%.1f%%), %.0f nodes per move\n", levelA, levelB,
+           wins, draws, losses, 100.0 * (wins + 0.5 * draws) / games, moves ? (double)nodes / moves : 0.0);
+    delete search;
+    delete context;
+    return 0;
+}
@@ -0,0 +1,235 @@
+// Puzzle database packer
+//
+// Reads mate puzzles in the Lichess puzzle CSV format
+//   PuzzleId,FEN,Moves,Rating,RatingDeviation,Popularity,NbPlays,Themes,...
+// where FEN is the position before the opponent's setup move and Moves
+// starts with that move. Each puzzle is replayed, checked with MateSolver
+// (the stored line must be a forced mate and no shorter mate may exist),
+// then packed into the 38-byte flash format and written as puzzle_data.h,
+// grouped by rating bucket.
+//
+// Puzzles the board cannot play are dropped: castling rights or an en
+// passant square in the FEN, castling or en passant in the line (puzzle
+// mode does not prompt for the rook or the captured pawn), under-promotions,
+// or mates longer than MATE_MAX_MOVES.
+//
+// Build on a Linux host from the repository root (one command):
+//   g++ -O2 -std=c++17 -I. tools/puzzle_pack.cpp chess_mate.cpp chess_engine.cpp
+//       chess_codec.cpp -o puzzle_pack
+//
+// Usage:
+//   ./puzzle_pack puzzles.csv [maxPerBucket] > puzzle_data.h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "chess_codec.h"
+#include "chess_mate.h"
+#include "puzzle_db.h"
+
+#define DEFAULT_PER_BUCKET  200
+#define SOLVER_NODE_LIMIT   2000000
+
+struct PackEntry {
+    PackedPuzzle packed;
+    std::vector<Move> solution;
+    std::string id;
+};
+
+static ChessEngine engine;
+static MateSolver solver(&engine);
+
+static std::vector<std::string> splitFields(const std::string &line, char separator) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    for (;;) {
+        size_t end = line.find(separator, start);
+        if (end == std::string::npos) {
+            fields.push_back(line.substr(start));
+            return fields;
+        }
+        fields.push_back(line.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+// Castling moves a second piece and en passant takes one off another square
+static bool isSpecialMove(const Position &pos, Move move) {
+    int from = moveFrom(move), to = moveTo(move);
+    char piece = pos.board[from >> 3][from & 7];
+    if ((piece == 'K' || piece == 'k') && (to - from == 2 || from - to == 2)) return true;
+    return (piece == 'P' || piece == 'p') && to == pos.epSquare;
+}
+
+// Replay and verify one CSV row; false (with a reason) if it is unusable
+static bool buildEntry(const std::vector<std::string> &fields, PackEntry &entry, const char* &reason) {
+    if (fields.size() < 4) { reason = "short row"; return false; }
+
+    std::vector<std::string> fenFields = splitFields(fields[1], ' ');
+    if (fenFields.size() < 4 || fenFields[2] != "-" || fenFields[3] != "-") {
+        reason = "castling or en passant";
+        return false;
+    }
+
+    Position pos;
+    if (!engine.setupPositionFromFEN(pos, fields[1].c_str())) { reason = "bad FEN"; return false; }
+
+    std::vector<std::string> moveText = splitFields(fields[2], ' ');
+    if (moveText.size() < 2 || moveText.size() % 2 != 0) { reason = "bad move list"; return false; }
+
+    std::vector<Move> line;
+    for (size_t i = 0; i < moveText.size(); i++) {
+        Move move = parseUciMove(moveText[i].c_str(), (int)moveText[i].size());
+        if (move == MOVE_NONE) { reason = "bad move"; return false; }
+        line.push_back(move);
+    }
+
+    // The first move is the opponent's; the puzzle starts after it
+    MoveUndo undo;
+    if (!engine.isLegalMove(pos, line[0])) { reason = "illegal setup move"; return false; }
+    engine.makeMove(pos, line[0], undo);
+    line.erase(line.begin());
+
+    int mateIn = (int)(line.size() + 1) / 2;
+    if ((int)line.size() > PUZZLE_MAX_PLIES || mateIn > MATE_MAX_MOVES) { reason = "too long"; return false; }
+
+    int solvedIn;
+    Move first = solver.solve(pos, mateIn, solvedIn, SOLVER_NODE_LIMIT);
+    if (first == MOVE_NONE || solvedIn != mateIn) { reason = "solver disagrees"; return false; }
+
+    // Every attacker move of the line must keep the mate on schedule, and
+    // the line must end in mate
+    Position replay = pos;
+    for (size_t i = 0; i < line.size(); i++) {
+        Move move = line[i];
+        int promotion = movePromotion(move);
+        if (promotion != PROMOTE_NONE && promotion != PROMOTE_QUEEN) { reason = "under-promotion"; return false; }
+        if (!engine.isLegalMove(replay, move)) { reason = "illegal solution move"; return false; }
+        if (isSpecialMove(replay, move)) { reason = "castling or en passant"; return false; }
+        if (i % 2 == 0 && !solver.isMatingMove(replay, move, mateIn - (int)i / 2, SOLVER_NODE_LIMIT)) {
+            reason = "solution move does not mate";
+            return false;
+        }
+        engine.makeMove(replay, move, undo);
+    }
+    Move replies[MAX_MOVES];
+    if (engine.generateLegalMoves(replay, replies) != 0 || !engine.isInCheck(replay, replay.whiteToMove)) {
+        reason = "line does not end in mate";
+        return false;
+    }
+
+    ChessEngine::packPosition(pos, entry.packed.position);
+    int rating = atoi(fields[3].c_str());
+    entry.packed.rating = (uint16_t)(rating < 0 ? 0 : rating);
+    entry.packed.mateIn = (uint8_t)mateIn;
+    entry.packed.solutionLength = (uint8_t)line.size();
+    entry.solution = line;
+    entry.id = fields[0];
+    return true;
+}
+
+static void writeHeader(std::vector<PackEntry> buckets[PUZZLE_BUCKET_COUNT]) {
+    int total = 0;
+    for (int b = 0; b < PUZZLE_BUCKET_COUNT; b++) total += (int)buckets[b].size();
+
+    printf("#ifndef PUZZLE_DATA_H\n#define PUZZLE_DATA_H\n\n");
+    printf("// Generated by tools/puzzle_pack.cpp - rerun the tool instead of editing by hand.\n");
+    printf("// Included by puzzle_db.cpp only.\n\n");
+    printf("#define PUZZLE_COUNT %d\n\n", total);
+
+    printf("static const PuzzleBucket PUZZLE_BUCKETS[PUZZLE_BUCKET_COUNT] = {\n");
+    int first = 0;
+    for (int b = 0; b < PUZZLE_BUCKET_COUNT; b++) {
+        printf("    {%d, %d},\n", first, (int)buckets[b].size());
+        first += (int)buckets[b].size();
+    }
+    printf("};\n\n");
+
+    printf("static const PackedPuzzle PUZZLES[PUZZLE_COUNT > 0 ? PUZZLE_COUNT : 1] = {\n");
+    int solutionStart = 0;
+    for (int b = 0; b < PUZZLE_BUCKET_COUNT; b++) {
+        for (size_t i = 0; i < buckets[b].size(); i++) {
+            const PackEntry &entry = buckets[b][i];
+            const PackedPuzzle &p = entry.packed;
+            const PackedPosition &position = p.position;
+            printf("    {{{");
+            for (int j = 0; j < 8; j++) printf(j ? ",0x%02X" : "0x%02X", position.occupancy[j]);
+            printf("}, {");
+            for (int j = 0; j < 16; j++) printf(j ? ",0x%02X" : "0x%02X", position.pieces[j]);
+            printf("}, 0x%02X, 0x%02X, %u, {0x%02X,0x%02X}, {0}}, %u, %d, %u, %u},  // %s\n",
+                   position.flags, position.enPassant, position.halfmoveClock,
+                   position.fullmoveNumber[0], position.fullmoveNumber[1],
+                   p.rating, solutionStart, p.mateIn, p.solutionLength, entry.id.c_str());
+            solutionStart += (int)entry.solution.size();
+        }
+    }
+    printf("};\n\n");
+
+    printf("static const Move PUZZLE_SOLUTIONS[%d] = {", solutionStart > 0 ? solutionStart : 1);
+    int column = 0;
+    for (int b = 0; b < PUZZLE_BUCKET_COUNT; b++) {
+        for (size_t i = 0; i < buckets[b].size(); i++) {
+            for (size_t j = 0; j < buckets[b][i].solution.size(); j++) {
+                printf(column % 10 == 0 ? "\n    0x%04X," : " 0x%04X,", buckets[b][i].solution[j]);
+                column++;
+            }
+        }
+    }
+    printf("\n};\n\n#endif // PUZZLE_DATA_H\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s puzzles.csv [maxPerBucket] > puzzle_data.h\n", argv[0]);
+        return 1;
+    }
+    FILE* file = fopen(argv[1], "r");
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    size_t maxPerBucket = argc > 2 ? (size_t)atoi(argv[2]) : DEFAULT_PER_BUCKET;
+
+    std::vector<PackEntry> buckets[PUZZLE_BUCKET_COUNT];
+    int read = 0, rejected = 0;
+    char buffer[1024];
+    while (fgets(buffer, sizeof(buffer), file)) {
+        std::string line(buffer);
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        if (line.empty() || line.compare(0, 8, "PuzzleId") == 0) continue;
+        read++;
+
+        std::vector<std::string> fields = splitFields(line, ',');
+        if (fields.size() >= 4) {
+            int bucket = PuzzleDB::bucketFor(atoi(fields[3].c_str()));
+            if (buckets[bucket].size() >= maxPerBucket) continue;
+        }
+
+        PackEntry entry;
+        const char* reason = "";
+        if (!buildEntry(fields, entry, reason)) {
+            fprintf(stderr, "skip %s: %s\n", fields[0].c_str(), reason);
+            rejected++;
+            continue;
+        }
+        buckets[PuzzleDB::bucketFor(entry.packed.rating)].push_back(entry);
+    }
+    fclose(file);
+
+    // Within a bucket, easiest first
+    for (int b = 0; b < PUZZLE_BUCKET_COUNT; b++) {
+        std::stable_sort(buckets[b].begin(), buckets[b].end(), [](const PackEntry &a, const PackEntry &b) {
+            return a.packed.rating < b.packed.rating;
+        });
+        fprintf(stderr, "bucket %d: %d puzzles\n", b, (int)buckets[b].size());
+    }
+    fprintf(stderr, "%d rows read, %d rejected\n", read, rejected);
+
+    writeHeader(buckets);
+    return 0;
+}
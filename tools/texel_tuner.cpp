@@ -0,0 +1,344 @@
+// Texel tuner for the hand-crafted evaluation (chess_eval.h)
+//
+// Reads labelled positions, resolves each one to a quiet position with the
+// engine's quiescence search, then fits the eval weights by gradient descent
+// on the squared error between sigmoid(eval) and the game result. The fitted
+// weights are written as eval_weights.h, which the firmware compiles in.
+//
+// Build on a Linux host from the repository root (one command):
+//   g++ -O3 -march=native -std=c++17 -pthread -I. tools/texel_tuner.cpp
+//       chess_engine.cpp chess_eval.cpp chess_search.cpp chess_history.cpp
+//       chess_nnue.cpp chess_time.cpp chess_tt.cpp -o texel_tuner
+//
+// Usage:
+//   ./texel_tuner positions.epd [--threads N] [--epochs N] [--rate R] [--out eval_weights.h]
+//
+// Each line holds a FEN/EPD position followed by the game result from White's
+// point of view, in any of the usual forms: [1.0] [0.5] [0.0], "1-0"
+// "1/2-1/2" "0-1", or an EPD c9 "1-0"; opcode.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chess_engine.h"
+#include "chess_eval.h"
+#include "chess_search.h"
+#include "eval_weights.h"
+
+// ---------------------------
+// Dataset
+// ---------------------------
+
+// One non-zero trace coefficient
+struct Feature {
+    uint16_t term;
+    int16_t count;
+};
+
+// A resolved position: its features live in features[first, first + count)
+struct Entry {
+    uint32_t first;
+    uint16_t count;
+    float phase;        // Middlegame share, 0..1
+    float result;       // 1 = White won, 0.5 = draw, 0 = Black won
+};
+
+struct Dataset {
+    std::vector<Entry> entries;
+    std::vector<Feature> features;
+};
+
+static bool parseResult(const std::string &line, float &result) {
+    size_t bracket = line.find('[');
+    if (bracket != std::string::npos) {
+        result = (float)atof(line.c_str() + bracket + 1);
+        return result >= 0.0f && result <= 1.0f;
+    }
+    if (line.find("1/2-1/2") != std::string::npos) result = 0.5f;
+    else if (line.find("1-0") != std::string::npos) result = 1.0f;
+    else if (line.find("0-1") != std::string::npos) result = 0.0f;
+    else return false;
+    return true;
+}
+
+// Run fn(begin, end, thread) over [0, count) split evenly across threads
+template <typename Fn>
+static void parallelFor(int threads, size_t count, Fn fn) {
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(fn, begin, end, t);
+    }
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+}
+
+static bool loadDataset(const char* path, int threads, Dataset &data) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+    std::vector<std::string> lines;
+    char buffer[512];
+    while (fgets(buffer, sizeof(buffer), file)) lines.push_back(buffer);
+    fclose(file);
+
+    // Each thread resolves its slice with its own search; the engine is stateless
+    ChessEngine engine;
+    std::vector<Dataset> parts(threads);
+    std::vector<size_t> skipped(threads, 0);
+    std::vector<size_t> mismatched(threads, 0);
+
+    parallelFor(threads, lines.size(), [&](size_t begin, size_t end, int t) {
+        ChessSearch* search = new ChessSearch(&engine);
+        ChessEval eval(&engine);
+        EvalTrace* trace = new EvalTrace;
+        Dataset &part = parts[t];
+
+        for (size_t i = begin; i < end; i++) {
+            Position pos;
+            float result;
+            if (!engine.setupPositionFromFEN(pos, lines[i].c_str()) || !parseResult(lines[i], result)) {
+                skipped[t]++;
+                continue;
+            }
+            search->resolveQuiet(pos);
+            int score = eval.evaluate(pos, trace);
+            if (!pos.whiteToMove) score = -score;
+
+            Entry entry;
+            entry.first = part.features.size();
+            entry.count = 0;
+            entry.phase = (float)trace->phase / EVAL_PHASE_MAX;
+            entry.result = result;
+
+            // The linear model must reproduce the engine's score up to rounding
+            double mg = 0, eg = 0;
+            for (int term = 0; term < EVAL_TERM_COUNT; term++) {
+                int16_t count = trace->coefficients[term];
+                if (count == 0) continue;
+                Feature feature = {(uint16_t)term, count};
+                part.features.push_back(feature);
+                entry.count++;
+                mg += count * EVAL_WEIGHTS[term][0];
+                eg += count * EVAL_WEIGHTS[term][1];
+            }
+            if (fabs(mg * entry.phase + eg * (1 - entry.phase) - score) > 1.0) mismatched[t]++;
+            part.entries.push_back(entry);
+        }
+        delete trace;
+        delete search;
+    });
+
+    size_t totalSkipped = 0, totalMismatched = 0;
+    for (int t = 0; t < threads; t++) {
+        uint32_t offset = data.features.size();
+        for (size_t i = 0; i < parts[t].entries.size(); i++) {
+            Entry entry = parts[t].entries[i];
+            entry.first += offset;
+            data.entries.push_back(entry);
+        }
+        data.features.insert(data.features.end(), parts[t].features.begin(), parts[t].features.end());
+        totalSkipped += skipped[t];
+        totalMismatched += mismatched[t];
+    }
+    if (totalSkipped) fprintf(stderr, "Skipped %zu unreadable lines\n", totalSkipped);
+    if (totalMismatched) fprintf(stderr, "Warning: %zu traces disagree with the evaluation\n", totalMismatched);
+    return !data.entries.empty();
+}
+
+// ---------------------------
+// Model
+// ---------------------------
+
+typedef std::vector<double> Weights;  // mg, eg interleaved per term
+
+static inline double linearEval(const Dataset &data, const Entry &entry, const Weights &w) {
+    double mg = 0, eg = 0;
+    const Feature* f = &data.features[entry.first];
+    for (int i = 0; i < entry.count; i++) {
+        mg += f[i].count * w[2 * f[i].term];
+        eg += f[i].count * w[2 * f[i].term + 1];
+    }
+    return mg * entry.phase + eg * (1 - entry.phase);
+}
+
+static inline double sigmoid(double k, double score) {
+    return 1.0 / (1.0 + pow(10.0, -k * score / 400.0));
+}
+
+static double meanSquaredError(const Dataset &data, const Weights &w, double k, int threads) {
+    std::vector<double> sums(threads, 0.0);
+    parallelFor(threads, data.entries.size(), [&](size_t begin, size_t end, int t) {
+        double sum = 0;
+        for (size_t i = begin; i < end; i++) {
+            double error = data.entries[i].result - sigmoid(k, linearEval(data, data.entries[i], w));
+            sum += error * error;
+        }
+        sums[t] = sum;
+    });
+    double total = 0;
+    for (int t = 0; t < threads; t++) total += sums[t];
+    return total / data.entries.size();
+}
+
+// Scaling constant that best maps the starting eval onto the results
+static double fitScale(const Dataset &data, const Weights &w, int threads) {
+    double low = 0.0, high = 5.0;
+    for (int i = 0; i < 40; i++) {
+        double a = low + (high - low) / 3;
+        double b = high - (high - low) / 3;
+        if (meanSquaredError(data, w, a, threads) < meanSquaredError(data, w, b, threads)) high = b;
+        else low = a;
+    }
+    return (low + high) / 2;
+}
+
+static void gradient(const Dataset &data, const Weights &w, double k, int threads, Weights &grad) {
+    std::vector<Weights> partial(threads, Weights(grad.size(), 0.0));
+    parallelFor(threads, data.entries.size(), [&](size_t begin, size_t end, int t) {
+        Weights &g = partial[t];
+        for (size_t i = begin; i < end; i++) {
+            const Entry &entry = data.entries[i];
+            double s = sigmoid(k, linearEval(data, entry, w));
+            double d = -2.0 * (entry.result - s) * s * (1 - s) * k * log(10.0) / 400.0;
+            double dmg = d * entry.phase;
+            double deg = d * (1 - entry.phase);
+            const Feature* f = &data.features[entry.first];
+            for (int j = 0; j < entry.count; j++) {
+                g[2 * f[j].term] += dmg * f[j].count;
+                g[2 * f[j].term + 1] += deg * f[j].count;
+            }
+        }
+    });
+    std::fill(grad.begin(), grad.end(), 0.0);
+    for (int t = 0; t < threads; t++) {
+        for (size_t i = 0; i < grad.size(); i++) grad[i] += partial[t][i] / data.entries.size();
+    }
+}
+
+// ---------------------------
+// Output
+// ---------------------------
+
+static bool writeHeader(const char* path, const Weights &w) {
+    static const struct { const char* name; int count; } groups[] = {
+        {"Material: P N B R Q K", 6},
+        {"Pawn square table", 64},
+        {"Knight square table", 64},
+        {"Bishop square table", 64},
+        {"Rook square table", 64},
+        {"Queen square table", 64},
+        {"King square table", 64},
+        {"Mobility per square: N B R Q", 4},
+        {"Bishop pair", 1},
+        {"Doubled pawn", 1},
+        {"Isolated pawn", 1},
+        {"Passed pawn by relative rank", 8},
+    };
+
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return false;
+    }
+    fprintf(out, "#ifndef EVAL_WEIGHTS_H\n#define EVAL_WEIGHTS_H\n\n");
+    fprintf(out, "// Generated by tools/texel_tuner.cpp - rerun the tuner instead of editing by hand.\n");
+    fprintf(out, "// {middlegame, endgame} per term, in EvalTerm order (see chess_eval.h).\n\n");
+    fprintf(out, "#include <stdint.h>\n\n");
+    fprintf(out, "static const int16_t EVAL_WEIGHTS[EVAL_TERM_COUNT][2] = {\n");
+    int term = 0;
+    for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); g++) {
+        fprintf(out, "    // %s\n", groups[g].name);
+        for (int i = 0; i < groups[g].count; i++) {
+            fprintf(out, i % 8 == 0 ? "    " : " ");
+            fprintf(out, "{%ld, %ld},", lround(w[2 * term]), lround(w[2 * term + 1]));
+            if (i % 8 == 7 || i == groups[g].count - 1) fprintf(out, "\n");
+            term++;
+        }
+    }
+    fprintf(out, "};\n\n#endif // EVAL_WEIGHTS_H\n");
+    fclose(out);
+    return term == EVAL_TERM_COUNT;
+}
+
+// ---------------------------
+// Main
+// ---------------------------
+
+int main(int argc, char** argv) {
+    const char* input = 0;
+    const char* output = "eval_weights.h";
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    int epochs = 500;
+    double rate = 1.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--threads") && i + 1 < argc) threads = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--epochs") && i + 1 < argc) epochs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rate") && i + 1 < argc) rate = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) output = argv[++i];
+        else if (argv[i][0] != '-') input = argv[i];
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (!input) {
+        fprintf(stderr, "Usage: %s positions.epd [--threads N] [--epochs N] [--rate R] [--out FILE]\n", argv[0]);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Dataset data;
+    if (!loadDataset(input, threads, data)) {
+        fprintf(stderr, "No usable positions in %s\n", input);
+        return 1;
+    }
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("Resolved %zu positions in %.1f s on %d threads\n", data.entries.size(), loadSeconds, threads);
+
+    Weights w(2 * EVAL_TERM_COUNT);
+    for (int term = 0; term < EVAL_TERM_COUNT; term++) {
+        w[2 * term] = EVAL_WEIGHTS[term][0];
+        w[2 * term + 1] = EVAL_WEIGHTS[term][1];
+    }
+
+    double k = fitScale(data, w, threads);
+    printf("K = %.4f, starting error %.6f\n", k, meanSquaredError(data, w, k, threads));
+
+    // Adam: per-weight step sizes cope with terms seen in very few positions
+    Weights grad(w.size()), m(w.size(), 0.0), v(w.size(), 0.0);
+    const double beta1 = 0.9, beta2 = 0.999, epsilon = 1e-8;
+    start = std::chrono::steady_clock::now();
+    for (int epoch = 1; epoch <= epochs; epoch++) {
+        gradient(data, w, k, threads, grad);
+        for (size_t i = 0; i < w.size(); i++) {
+            m[i] = beta1 * m[i] + (1 - beta1) * grad[i];
+            v[i] = beta2 * v[i] + (1 - beta2) * grad[i] * grad[i];
+            double mHat = m[i] / (1 - pow(beta1, epoch));
+            double vHat = v[i] / (1 - pow(beta2, epoch));
+            w[i] -= rate * mHat / (sqrt(vHat) + epsilon);
+        }
+
+        if (epoch % 25 == 0 || epoch == epochs) {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            printf("Epoch %d  error %.6f  %.1fM positions/min\n", epoch, meanSquaredError(data, w, k, threads),
+                   epoch * (double)data.entries.size() / seconds * 60.0 / 1e6);
+        }
+    }
+
+    if (!writeHeader(output, w)) return 1;
+    printf("Wrote %s\n", output);
+    return 0;
+}
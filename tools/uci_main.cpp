@@ -0,0 +1,87 @@
+// UCI engine binary for Linux hosts
+//
+// Runs the on-board engine behind the UCI protocol so it can play in
+// standard tournament managers (cutechess-cli, fastchess, ...) and be
+// profiled with the usual tools. A reader thread queues stdin lines; the
+// engine consumes them on the main thread and polls the queue while it
+// searches, which is the same single-threaded model the board uses.
+//
+// Build on a Linux host from the repository root (one command):
+//   g++ -O3 -march=native -std=c++17 -pthread -I. tools/uci_main.cpp
+//       uci_engine.cpp chess_engine.cpp chess_eval.cpp chess_search.cpp
+//       chess_history.cpp chess_nnue.cpp chess_time.cpp chess_tt.cpp chess_context.cpp
+//       chess_codec.cpp -o openchess-uci
+
+#include <stdio.h>
+#include <string.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chess_engine.h"
+#include "chess_search.h"
+#include "chess_tt.h"
+#include "uci_engine.h"
+
+#define HOST_TT_ENTRIES     (1 << 20)   // 12 MB
+
+static std::mutex inputMutex;
+static std::condition_variable inputReady;
+static std::deque<std::string> inputLines;
+
+static void outputLine(const char* line) {
+    fputs(line, stdout);
+    fputc('\n', stdout);
+    fflush(stdout);
+}
+
+// Non-blocking read used while searching
+static bool pollLine(char* buffer, int size) {
+    std::lock_guard<std::mutex> lock(inputMutex);
+    if (inputLines.empty()) return false;
+    snprintf(buffer, size, "%s", inputLines.front().c_str());
+    inputLines.pop_front();
+    return true;
+}
+
+static void readInput() {
+    static char line[UCI_MAX_LINE];
+    while (fgets(line, sizeof(line), stdin)) {
+        std::lock_guard<std::mutex> lock(inputMutex);
+        inputLines.push_back(line);
+        inputReady.notify_one();
+    }
+    // End of input acts as quit
+    std::lock_guard<std::mutex> lock(inputMutex);
+    inputLines.push_back("quit");
+    inputReady.notify_one();
+}
+
+int main() {
+    static ChessEngine engine;
+    static ChessSearch search(&engine);
+    static std::vector<TTEntry> storage(HOST_TT_ENTRIES);
+    static TranspositionTable table;
+    table.init(storage.data(), HOST_TT_ENTRIES);
+    search.setTranspositionTable(&table);
+
+    UciEngine uci(&engine, &search, outputLine, pollLine);
+    std::thread reader(readInput);
+    reader.detach();
+
+    for (;;) {
+        std::string line;
+        {
+            std::unique_lock<std::mutex> lock(inputMutex);
+            inputReady.wait(lock, [] { return !inputLines.empty(); });
+            line = inputLines.front();
+            inputLines.pop_front();
+        }
+        if (!uci.handleCommand(line.c_str())) break;
+    }
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include "uci_engine.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------
+// Token Helpers
+// ---------------------------
+
+static bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static const char* skipSpaces(const char* p) {
+    while (*p != '\0' && isSeparator(*p)) p++;
+    return p;
+}
+
+// Skip the current token and the spaces after it
+static const char* nextToken(const char* p) {
+    while (*p != '\0' && !isSeparator(*p)) p++;
+    return skipSpaces(p);
+}
+
+// If p starts with the whole word, advance past it and return true
+static bool matchWord(const char* &p, const char* word) {
+    size_t length = strlen(word);
+    if (strncmp(p, word, length) != 0) return false;
+    if (p[length] != '\0' && !isSeparator(p[length])) return false;
+    p = skipSpaces(p + length);
+    return true;
+}
+
+// ---------------------------
+// UciEngine Implementation
+// ---------------------------
+
+UciEngine::UciEngine(const ChessEngine* ce, ChessSearch* cs, void (*outputLine)(const char* line),
+                     bool (*pollLine)(char* buffer, int size)) : game(ce) {
+    search = cs;
+    output = outputLine;
+    readLine = pollLine;
+    multiPV = 1;
+    quitRequested = false;
+    stopRequested = false;
+    pendingLength = 0;
+    runningLength = 0;
+}
+
+bool UciEngine::handleCommand(const char* line) {
+    // A new session after "quit" starts with nothing left over
+    if (quitRequested) {
+        quitRequested = false;
+        pendingLength = 0;
+    }
+    
+    // The line is queued and run from the queue, so the caller's buffer is
+    // free for the transport to read into while it searches
+    int length = strlen(line);
+    if (length > UCI_MAX_LINE - 1) length = UCI_MAX_LINE - 1;
+    if (UCI_PENDING_SIZE - pendingLength <= length) pendingLength = 0;
+    memcpy(pending + pendingLength, line, length);
+    pending[pendingLength + length] = '\0';
+    pendingLength += length + 1;
+    
+    // Then the commands that arrived while it searched, in order
+    while (pendingLength > 0 && !quitRequested) {
+        runningLength = strlen(pending) + 1;
+        runCommand(pending);
+        runningLength = 0;
+        dropPendingLine(0);
+    }
+    return !quitRequested;
+}
+
+void UciEngine::runCommand(const char* line) {
+    const char* p = skipSpaces(line);
+
+    if (matchWord(p, "uci")) {
+        send("id name OpenChess");
+        send("id author OpenChess contributors");
+        send("option name MultiPV type spin default 1 min 1 max %d", MAX_PV_LINES);
+        send("uciok");
+    } else if (matchWord(p, "isready")) {
+        send("readyok");
+    } else if (matchWord(p, "ucinewgame")) {
+        search->newGame();
+        setPosition("startpos");
+    } else if (matchWord(p, "position")) {
+        setPosition(p);
+    } else if (matchWord(p, "go")) {
+        go(p);
+    } else if (matchWord(p, "setoption")) {
+        if (matchWord(p, "name") && matchWord(p, "MultiPV") && matchWord(p, "value")) {
+            multiPV = atoi(p);
+            if (multiPV < 1) multiPV = 1;
+            if (multiPV > MAX_PV_LINES) multiPV = MAX_PV_LINES;
+        }
+    } else if (matchWord(p, "quit")) {
+        quitRequested = true;
+    }
+    // Anything else, including "stop" with no search running, is ignored
+}
+
+void UciEngine::setPosition(const char* args) {
+    const char* p = args;
+    bool valid = true;
+    if (matchWord(p, "fen")) {
+        valid = game.setPositionFromFEN(p);
+    } else if (matchWord(p, "startpos")) {
+        game.setStartPosition();
+    } else {
+        valid = false;
+    }
+    if (!valid) {
+        send("info string invalid position, using the start position");
+        game.setStartPosition();
+    }
+
+    const char* moves = strstr(p, "moves");
+    if (moves == 0) return;
+    for (p = skipSpaces(moves + 5); *p != '\0'; p = nextToken(p)) {
+        int length = 0;
+        while (p[length] != '\0' && !isSeparator(p[length])) length++;
+        if (!game.playMove(parseUciMove(p, length))) {
+            send("info string illegal move %.*s", length, p);
+            return;
+        }
+    }
+}
+
+void UciEngine::go(const char* args) {
+    SearchLimits limits;
+    uint32_t clock[2] = {0, 0};
+    uint32_t increment[2] = {0, 0};
+    uint32_t movesToGo = 0;
+    bool haveClock = false;
+    bool infinite = false;
+
+    const char* p = args;
+    while (*p != '\0') {
+        if (matchWord(p, "depth")) limits.maxDepth = atoi(p);
+        else if (matchWord(p, "nodes")) limits.nodeLimit = strtoul(p, 0, 10);
+        else if (matchWord(p, "movetime")) limits.moveTimeMs = strtoul(p, 0, 10);
+        else if (matchWord(p, "wtime")) { clock[0] = strtoul(p, 0, 10); haveClock = true; }
+        else if (matchWord(p, "btime")) { clock[1] = strtoul(p, 0, 10); haveClock = true; }
+        else if (matchWord(p, "winc")) increment[0] = strtoul(p, 0, 10);
+        else if (matchWord(p, "binc")) increment[1] = strtoul(p, 0, 10);
+        else if (matchWord(p, "movestogo")) movesToGo = strtoul(p, 0, 10);
+        else if (matchWord(p, "infinite")) { infinite = true; continue; }
+        p = nextToken(p);
+    }
+
+    // Spread the remaining clock over the moves left, never risking more than a third of it
+    int side = game.pos.whiteToMove ? 0 : 1;
+    if (limits.moveTimeMs == 0 && haveClock) {
+        uint32_t budget = clock[side] / (movesToGo ? movesToGo : UCI_DEFAULT_MOVES_TO_GO)
+                        + increment[side] * 3 / 4;
+        if (budget > clock[side] / 3) budget = clock[side] / 3;
+        limits.moveTimeMs = budget;
+    }
+    if (limits.moveTimeMs != 0) {
+        limits.moveTimeMs = limits.moveTimeMs > 2 * UCI_MOVE_OVERHEAD_MS ? limits.moveTimeMs - UCI_MOVE_OVERHEAD_MS
+                                                                         : limits.moveTimeMs / 2 + 1;
+    }
+
+    SearchLine lines[MAX_PV_LINES];
+    stopRequested = false;
+    search->setObserver(this);
+    int count = search->analyze(game, limits, lines, multiPV);
+    
+    // An infinite search may end on its own (mate found, depth limit); its
+    // bestmove still waits for "stop"
+    while (infinite && readLine != 0 && !stopRequested) poll();
+    search->setObserver(0);
+
+    if (count == 0) {
+        send("bestmove 0000");
+        return;
+    }
+    char best[MOVE_TEXT_SIZE], ponder[MOVE_TEXT_SIZE];
+    formatUciMove(lines[0].pv[0], best);
+    if (lines[0].pvLength > 1) {
+        formatUciMove(lines[0].pv[1], ponder);
+        send("bestmove %s ponder %s", best, ponder);
+    } else {
+        send("bestmove %s", best);
+    }
+}
+
+void UciEngine::iterationComplete(int depth, const SearchLine lines[], int lineCount,
+                                  uint32_t nodes, uint32_t elapsedMs) {
+    unsigned long nps = elapsedMs ? (unsigned long)((uint64_t)nodes * 1000 / elapsedMs) : nodes;
+
+    for (int i = 0; i < lineCount; i++) {
+        char score[24];
+        int value = lines[i].score;
+        if (value >= SCORE_MATE - SEARCH_MAX_PLY) {
+            snprintf(score, sizeof(score), "mate %d", (SCORE_MATE - value + 1) / 2);
+        } else if (value <= -SCORE_MATE + SEARCH_MAX_PLY) {
+            snprintf(score, sizeof(score), "mate -%d", (SCORE_MATE + value) / 2);
+        } else {
+            snprintf(score, sizeof(score), "cp %d", value);
+        }
+
+        char pv[SEARCH_MAX_PLY * MOVE_TEXT_SIZE + 1];
+        int length = 0;
+        for (int j = 0; j < lines[i].pvLength; j++) {
+            if (j > 0) pv[length++] = ' ';
+            length += formatUciMove(lines[i].pv[j], pv + length);
+        }
+        pv[length] = '\0';
+
+        send("info depth %d multipv %d score %s nodes %lu nps %lu hashfull %d time %lu pv %s",
+             depth, i + 1, score, (unsigned long)nodes, nps, search->hashfull(), (unsigned long)elapsedMs, pv);
+    }
+}
+
+// Reads the lines that arrive while a search is running. "isready" is
+// answered out of turn and the rest join the queue, where a "stop" or
+// "quit" ends this search unless a queued "go" comes before it.
+void UciEngine::poll() {
+    // With no room left for a full line, the rest stays with the transport
+    while (readLine != 0 && UCI_PENDING_SIZE - pendingLength >= UCI_MAX_LINE) {
+        char* line = pending + pendingLength;
+        if (!readLine(line, UCI_MAX_LINE)) break;
+        const char* p = skipSpaces(line);
+        if (matchWord(p, "isready")) {
+            send("readyok");
+        } else if (*p != '\0') {
+            pendingLength += strlen(line) + 1;
+        }
+    }
+    
+    int offset = runningLength;
+    while (offset < pendingLength) {
+        const char* p = skipSpaces(pending + offset);
+        if (matchWord(p, "go")) break;
+        if (matchWord(p, "quit")) {
+            quitRequested = true;
+        } else if (!matchWord(p, "stop")) {
+            offset += strlen(pending + offset) + 1;
+            continue;
+        }
+        stopRequested = true;
+        search->requestStop();
+        dropPendingLine(offset);
+    }
+}
+
+void UciEngine::dropPendingLine(int offset) {
+    int length = strlen(pending + offset) + 1;
+    pendingLength -= length;
+    memmove(pending + offset, pending + offset + length, pendingLength - offset);
+}
+
+void UciEngine::send(const char* format, ...) {
+    char line[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    output(line);
+}
@@ -0,0 +1,68 @@
+#ifndef UCI_ENGINE_H
+#define UCI_ENGINE_H
+
+#include "chess_codec.h"
+#include "chess_context.h"
+#include "chess_search.h"
+
+// ---------------------------
+// UCI Configuration
+// ---------------------------
+#ifndef UCI_MAX_LINE
+#if defined(ARDUINO_ARCH_SAMD)
+#define UCI_MAX_LINE            512     // 32 KB of RAM: room for about 100 moves of history
+#else
+#define UCI_MAX_LINE            2048    // "position ... moves" lines grow with the game
+#endif
+#endif
+#define UCI_MOVE_OVERHEAD_MS    30      // Kept back from every time budget for I/O
+#define UCI_DEFAULT_MOVES_TO_GO 30      // Assumed when the GUI sends no movestogo
+#define UCI_PENDING_SIZE        (2 * UCI_MAX_LINE)  // Commands queued behind a running search
+
+// ---------------------------
+// UCI Engine Class
+// ---------------------------
+// Universal Chess Interface front-end for ChessSearch. It is transport
+// agnostic: commands come in as lines, replies go out through outputLine,
+// and while a search runs it polls pollLine (if given). "isready" is
+// answered at once and "stop" or "quit" end the search; other commands are
+// queued and run once it is over, so a "stop" behind a queued "go" is left
+// for that later search.
+// The Linux build feeds it stdin, the board feeds it the Serial port.
+class UciEngine : public SearchObserver {
+private:
+    ChessSearch* search;
+    void (*output)(const char* line);
+    bool (*readLine)(char* buffer, int size);
+    
+    GameContext game;
+    int multiPV;
+    bool quitRequested;
+    bool stopRequested;
+    
+    // Lines not yet run, back to back with their terminators. The one being
+    // run stays at the front, runningLength bytes long, until it is done.
+    char pending[UCI_PENDING_SIZE];
+    int pendingLength;
+    int runningLength;
+    
+    void runCommand(const char* line);
+    void dropPendingLine(int offset);
+    void send(const char* format, ...);
+    void setPosition(const char* args);
+    void go(const char* args);
+    
+public:
+    UciEngine(const ChessEngine* ce, ChessSearch* cs, void (*outputLine)(const char* line),
+              bool (*pollLine)(char* buffer, int size) = 0);
+    
+    // Handle one command line; returns false once "quit" has been received
+    bool handleCommand(const char* line);
+    
+    // SearchObserver
+    void iterationComplete(int depth, const SearchLine lines[], int lineCount,
+                           uint32_t nodes, uint32_t elapsedMs);
+    void poll();
+};
+
+#endif // UCI_ENGINE_H
@@ -19,12 +19,14 @@ WiFiManager::WiFiManager() : server(AP_PORT) {
     boardEvaluation = 0.0;
     
     // Initialize board state to empty
+    char empty[8][8];
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
-            boardState[row][col] = ' ';
-            pendingBoardEdit[row][col] = ' ';
+            empty[row][col] = ' ';
         }
     }
+    ChessEngine::packPosition(empty, true, boardState);
+    pendingBoardEdit = boardState;
 }
 
 void WiFiManager::begin() {
@@ -165,6 +167,10 @@ void WiFiManager::handleClient() {
             String gameSelectionPage = generateGameSelectionPage();
             sendResponse(client, gameSelectionPage);
         }
+        else if (request.indexOf("GET /board-packed") >= 0) {
+            // Board state as a packed position in hex
+            sendResponse(client, generateBoardPacked(), "text/plain");
+        }
         else if (request.indexOf("GET /board") >= 0) {
             // Board state JSON API
             String boardJSON = generateBoardJSON();
@@ -344,6 +350,7 @@ String WiFiManager::generateGameSelectionPage() {
     html += ".game-mode.mode-2 { border-color: #FFFFFF; background: linear-gradient(135deg, #444 0%, #FFFFFF 100%); }";
     html += ".game-mode.mode-3 { border-color: #2196F3; background: linear-gradient(135deg, #444 0%, #2196F3 100%); }";
     html += ".game-mode.mode-4 { border-color: #F44336; background: linear-gradient(135deg, #444 0%, #F44336 100%); }";
+    html += ".game-mode.mode-5 { border-color: #8000FF; background: linear-gradient(135deg, #444 0%, #8000FF 100%); }";
     html += ".game-mode h3 { margin: 0 0 10px 0; font-size: 18px; }";
     html += ".game-mode p { margin: 0; font-size: 14px; opacity: 0.8; }";
     html += ".status { font-size: 12px; padding: 5px 10px; border-radius: 15px; margin-top: 10px; display: inline-block; }";
@@ -382,6 +389,12 @@ String WiFiManager::generateGameSelectionPage() {
     html += "<span class=\"status\">Available</span>";
     html += "</div>";
     
+    html += "<div class=\"game-mode available mode-5\" onclick=\"selectGame(5)\">";
+    html += "<h3>Puzzles</h3>";
+    html += "<p>Mate puzzles, rated by difficulty</p>";
+    html += "<span class=\"status\">Available</span>";
+    html += "</div>";
+    
     html += "</div>";
     html += "<a href=\"/board-view\" class=\"button\">View Chess Board</a>";
     html += "<a href=\"/\" class=\"back-button\">Back to Configuration</a>";
@@ -389,7 +402,7 @@ String WiFiManager::generateGameSelectionPage() {
     
     html += "<script>";
     html += "function selectGame(mode) {";
-    html += "if (mode === 1 || mode === 2 || mode === 3 || mode === 4) {";
+    html += "if (mode >= 1 && mode <= 5) {";
     html += "fetch('/gameselect', { method: 'POST', headers: { 'Content-Type': 'application/x-www-form-urlencoded' }, body: 'gamemode=' + mode })";
     html += ".then(response => response.text())";
     html += ".then(data => { alert('Game mode ' + mode + ' selected! Check your chess board.'); })";
@@ -493,24 +506,24 @@ void WiFiManager::updateBoardState(char newBoardState[8][8]) {
     updateBoardState(newBoardState, 0.0);
 }
 
-void WiFiManager::updateBoardState(char newBoardState[8][8], float evaluation) {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            boardState[row][col] = newBoardState[row][col];
-        }
-    }
+void WiFiManager::updateBoardState(char newBoardState[8][8], float evaluation, bool whiteToMove) {
+    ChessEngine::packPosition(newBoardState, whiteToMove, boardState);
     boardStateValid = true;
     boardEvaluation = evaluation;
 }
 
 String WiFiManager::generateBoardJSON() {
+    char board[8][8];
+    bool whiteToMove;
+    ChessEngine::unpackBoard(boardState, board, whiteToMove);
+    
     String json = "{";
     json += "\"board\":[";
     
     for (int row = 0; row < 8; row++) {
         json += "[";
         for (int col = 0; col < 8; col++) {
-            char piece = boardState[row][col];
+            char piece = board[row][col];
             if (piece == ' ') {
                 json += "\"\"";
             } else {
@@ -532,6 +545,14 @@ String WiFiManager::generateBoardJSON() {
     return json;
 }
 
+// The same board in 64 hex characters (see PackedPosition), for clients
+// that poll often: about a fifth of the JSON above
+String WiFiManager::generateBoardPacked() {
+    char hex[PACKED_HEX_LENGTH + 1];
+    ChessEngine::packedToHex(boardState, hex);
+    return String(hex);
+}
+
 String WiFiManager::generateBoardViewPage() {
     String html = "<!DOCTYPE html>";
     html += "<html lang=\"en\">";
@@ -563,6 +584,10 @@ String WiFiManager::generateBoardViewPage() {
     html += "<h2>CHESS BOARD</h2>";
     
     if (boardStateValid) {
+        char board[8][8];
+        bool whiteToMove;
+        ChessEngine::unpackBoard(boardState, board, whiteToMove);
+        
         html += "<div class=\"status\">Board state: Active</div>";
         // Show evaluation if available (for Chess Bot mode)
         if (boardEvaluation != 0.0) {
@@ -587,7 +612,7 @@ String WiFiManager::generateBoardViewPage() {
         for (int row = 0; row < 8; row++) {
             for (int col = 0; col < 8; col++) {
                 bool isLight = (row + col) % 2 == 0;
-                char piece = boardState[row][col];
+                char piece = board[row][col];
                 
                 html += "<div class=\"square " + String(isLight ? "light" : "dark") + "\">";
                 
@@ -761,6 +786,10 @@ String WiFiManager::generateBoardEditPage() {
     html += "<h2>EDIT CHESS BOARD</h2>";
     html += "<div class=\"status\">Click on any square to change the piece. Empty = no piece.</div>";
     
+    char board[8][8];
+    bool whiteToMove;
+    ChessEngine::unpackBoard(boardState, board, whiteToMove);
+    
     html += "<form id=\"boardForm\" method=\"POST\" action=\"/board-edit\">";
     html += "<div class=\"board-container\">";
     html += "<div class=\"board\">";
@@ -769,7 +798,7 @@ String WiFiManager::generateBoardEditPage() {
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
             bool isLight = (row + col) % 2 == 0;
-            char piece = boardState[row][col];
+            char piece = board[row][col];
             
             html += "<div class=\"square " + String(isLight ? "light" : "dark") + "\">";
             html += "<select name=\"r" + String(row) + "c" + String(col) + "\" id=\"r" + String(row) + "c" + String(col) + "\">";
@@ -859,7 +888,26 @@ void WiFiManager::handleBoardEdit(WiFiClient& client, String request, String bod
 }
 
 void WiFiManager::parseBoardEditData(String data) {
-    // Parse the form data which contains r0c0, r0c1, etc.
+    // A client may send the whole board as packed=<64 hex digits>
+    int packedStart = data.indexOf("packed=");
+    if (packedStart >= 0) {
+        PackedPosition packed;
+        char board[8][8];
+        bool whiteToMove;
+        String hex = data.substring(packedStart + 7, packedStart + 7 + PACKED_HEX_LENGTH);
+        if (hex.length() == PACKED_HEX_LENGTH && ChessEngine::packedFromHex(hex.c_str(), packed) &&
+            ChessEngine::unpackBoard(packed, board, whiteToMove)) {
+            pendingBoardEdit = packed;
+            hasPendingEdit = true;
+            Serial.println("Packed board edit received and stored");
+        } else {
+            Serial.println("Ignoring malformed packed board edit");
+        }
+        return;
+    }
+    
+    // Otherwise parse the form data which contains r0c0, r0c1, etc.
+    char board[8][8];
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
             String paramName = "r" + String(row) + "c" + String(col) + "=";
@@ -875,27 +923,25 @@ void WiFiManager::parseBoardEditData(String data) {
                 value.replace("%20", " ");
                 
                 if (value.length() > 0) {
-                    pendingBoardEdit[row][col] = value.charAt(0);
+                    board[row][col] = value.charAt(0);
                 } else {
-                    pendingBoardEdit[row][col] = ' ';
+                    board[row][col] = ' ';
                 }
             } else {
-                pendingBoardEdit[row][col] = ' ';
+                board[row][col] = ' ';
             }
         }
     }
     
+    ChessEngine::packPosition(board, true, pendingBoardEdit);
     hasPendingEdit = true;
     Serial.println("Board edit received and stored");
 }
 
 bool WiFiManager::getPendingBoardEdit(char editBoard[8][8]) {
     if (hasPendingEdit) {
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                editBoard[row][col] = pendingBoardEdit[row][col];
-            }
-        }
+        bool whiteToMove;
+        ChessEngine::unpackBoard(pendingBoardEdit, editBoard, whiteToMove);
         return true;
     }
     return false;
@@ -15,12 +15,14 @@ WiFiManagerESP32::WiFiManagerESP32() : server(AP_PORT) {
     boardEvaluation = 0.0;
     
     // Initialize board state to empty
+    char empty[8][8];
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
-            boardState[row][col] = ' ';
-            pendingBoardEdit[row][col] = ' ';
+            empty[row][col] = ' ';
         }
     }
+    ChessEngine::packPosition(empty, true, boardState);
+    pendingBoardEdit = boardState;
 }
 
 void WiFiManagerESP32::begin() {
@@ -97,6 +99,7 @@ void WiFiManagerESP32::begin() {
         this->server.send(200, "text/html", gameSelectionPage);
     });
     server.on("/board", HTTP_GET, [this]() { this->handleBoard(); });
+    server.on("/board-packed", HTTP_GET, [this]() { this->sendResponse(this->generateBoardPacked(), "text/plain"); });
     server.on("/board-view", HTTP_GET, [this]() { this->handleBoardView(); });
     server.on("/board-edit", HTTP_GET, [this]() { 
         String boardEditPage = this->generateBoardEditPage();
@@ -313,6 +316,7 @@ String WiFiManagerESP32::generateGameSelectionPage() {
     html += ".game-mode.mode-2 { border-color: #FFFFFF; background: linear-gradient(135deg, #444 0%, #FFFFFF 100%); }";
     html += ".game-mode.mode-3 { border-color: #2196F3; background: linear-gradient(135deg, #444 0%, #2196F3 100%); }";
     html += ".game-mode.mode-4 { border-color: #F44336; background: linear-gradient(135deg, #444 0%, #F44336 100%); }";
+    html += ".game-mode.mode-5 { border-color: #8000FF; background: linear-gradient(135deg, #444 0%, #8000FF 100%); }";
     html += ".game-mode h3 { margin: 0 0 10px 0; font-size: 18px; }";
     html += ".game-mode p { margin: 0; font-size: 14px; opacity: 0.8; }";
     html += ".status { font-size: 12px; padding: 5px 10px; border-radius: 15px; margin-top: 10px; display: inline-block; }";
@@ -351,6 +355,12 @@ String WiFiManagerESP32::generateGameSelectionPage() {
     html += "<span class=\"status\">Available</span>";
     html += "</div>";
     
+    html += "<div class=\"game-mode available mode-5\" onclick=\"selectGame(5)\">";
+    html += "<h3>Puzzles</h3>";
+    html += "<p>Mate puzzles, rated by difficulty</p>";
+    html += "<span class=\"status\">Available</span>";
+    html += "</div>";
+    
     html += "</div>";
     html += "<a href=\"/board-view\" class=\"button\">View Chess Board</a>";
     html += "<a href=\"/\" class=\"back-button\">Back to Configuration</a>";
@@ -358,7 +368,7 @@ String WiFiManagerESP32::generateGameSelectionPage() {
     
     html += "<script>";
     html += "function selectGame(mode) {";
-    html += "if (mode === 1 || mode === 2 || mode === 3 || mode === 4) {";
+    html += "if (mode >= 1 && mode <= 5) {";
     html += "fetch('/gameselect', { method: 'POST', headers: { 'Content-Type': 'application/x-www-form-urlencoded' }, body: 'gamemode=' + mode })";
     html += ".then(response => response.text())";
     html += ".then(data => { alert('Game mode ' + mode + ' selected! Check your chess board.'); })";
@@ -439,24 +449,24 @@ void WiFiManagerESP32::updateBoardState(char newBoardState[8][8]) {
     updateBoardState(newBoardState, 0.0);
 }
 
-void WiFiManagerESP32::updateBoardState(char newBoardState[8][8], float evaluation) {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            boardState[row][col] = newBoardState[row][col];
-        }
-    }
+void WiFiManagerESP32::updateBoardState(char newBoardState[8][8], float evaluation, bool whiteToMove) {
+    ChessEngine::packPosition(newBoardState, whiteToMove, boardState);
     boardStateValid = true;
     boardEvaluation = evaluation;
 }
 
 String WiFiManagerESP32::generateBoardJSON() {
+    char board[8][8];
+    bool whiteToMove;
+    ChessEngine::unpackBoard(boardState, board, whiteToMove);
+    
     String json = "{";
     json += "\"board\":[";
     
     for (int row = 0; row < 8; row++) {
         json += "[";
         for (int col = 0; col < 8; col++) {
-            char piece = boardState[row][col];
+            char piece = board[row][col];
             if (piece == ' ') {
                 json += "\"\"";
             } else {
@@ -478,6 +488,14 @@ String WiFiManagerESP32::generateBoardJSON() {
     return json;
 }
 
+// The same board in 64 hex characters (see PackedPosition), for clients
+// that poll often: about a fifth of the JSON above
+String WiFiManagerESP32::generateBoardPacked() {
+    char hex[PACKED_HEX_LENGTH + 1];
+    ChessEngine::packedToHex(boardState, hex);
+    return String(hex);
+}
+
 void WiFiManagerESP32::handleBoard() {
     String boardJSON = generateBoardJSON();
     sendResponse(boardJSON, "application/json");
@@ -519,6 +537,10 @@ String WiFiManagerESP32::generateBoardViewPage() {
     html += "<h2>CHESS BOARD</h2>";
     
     if (boardStateValid) {
+        char board[8][8];
+        bool whiteToMove;
+        ChessEngine::unpackBoard(boardState, board, whiteToMove);
+        
         html += "<div class=\"status\">Board state: Active</div>";
         // Show evaluation if available (for Chess Bot mode)
         if (boardEvaluation != 0.0) {
@@ -543,7 +565,7 @@ String WiFiManagerESP32::generateBoardViewPage() {
         for (int row = 0; row < 8; row++) {
             for (int col = 0; col < 8; col++) {
                 bool isLight = (row + col) % 2 == 0;
-                char piece = boardState[row][col];
+                char piece = board[row][col];
                 
                 html += "<div class=\"square " + String(isLight ? "light" : "dark") + "\">";
                 
@@ -716,6 +738,10 @@ String WiFiManagerESP32::generateBoardEditPage() {
     html += "<h2>EDIT CHESS BOARD</h2>";
     html += "<div class=\"status\">Click on any square to change the piece. Empty = no piece.</div>";
     
+    char board[8][8];
+    bool whiteToMove;
+    ChessEngine::unpackBoard(boardState, board, whiteToMove);
+    
     html += "<form id=\"boardForm\" method=\"POST\" action=\"/board-edit\">";
     html += "<div class=\"board-container\">";
     html += "<div class=\"board\">";
@@ -724,7 +750,7 @@ String WiFiManagerESP32::generateBoardEditPage() {
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
             bool isLight = (row + col) % 2 == 0;
-            char piece = boardState[row][col];
+            char piece = board[row][col];
             
             html += "<div class=\"square " + String(isLight ? "light" : "dark") + "\">";
             html += "<select name=\"r" + String(row) + "c" + String(col) + "\" id=\"r" + String(row) + "c" + String(col) + "\">";
@@ -814,7 +840,25 @@ void WiFiManagerESP32::handleBoardEdit() {
 }
 
 void WiFiManagerESP32::parseBoardEditData() {
-    // Parse the form data which contains r0c0, r0c1, etc.
+    // A client may send the whole board as packed=<64 hex digits>
+    if (server.hasArg("packed")) {
+        PackedPosition packed;
+        char board[8][8];
+        bool whiteToMove;
+        String hex = server.arg("packed");
+        if (hex.length() == PACKED_HEX_LENGTH && ChessEngine::packedFromHex(hex.c_str(), packed) &&
+            ChessEngine::unpackBoard(packed, board, whiteToMove)) {
+            pendingBoardEdit = packed;
+            hasPendingEdit = true;
+            Serial.println("Packed board edit received and stored");
+        } else {
+            Serial.println("Ignoring malformed packed board edit");
+        }
+        return;
+    }
+    
+    // Otherwise parse the form data which contains r0c0, r0c1, etc.
+    char board[8][8];
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
             String paramName = "r" + String(row) + "c" + String(col);
@@ -822,27 +866,25 @@ void WiFiManagerESP32::parseBoardEditData() {
             if (server.hasArg(paramName)) {
                 String value = server.arg(paramName);
                 if (value.length() > 0) {
-                    pendingBoardEdit[row][col] = value.charAt(0);
+                    board[row][col] = value.charAt(0);
                 } else {
-                    pendingBoardEdit[row][col] = ' ';
+                    board[row][col] = ' ';
                 }
             } else {
-                pendingBoardEdit[row][col] = ' ';
+                board[row][col] = ' ';
             }
         }
     }
     
+    ChessEngine::packPosition(board, true, pendingBoardEdit);
     hasPendingEdit = true;
     Serial.println("Board edit received and stored");
 }
 
 bool WiFiManagerESP32::getPendingBoardEdit(char editBoard[8][8]) {
     if (hasPendingEdit) {
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                editBoard[row][col] = pendingBoardEdit[row][col];
-            }
-        }
+        bool whiteToMove;
+        ChessEngine::unpackBoard(pendingBoardEdit, editBoard, whiteToMove);
         return true;
     }
     return false;
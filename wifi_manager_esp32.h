@@ -15,6 +15,8 @@
 #include <WiFi.h>
 #include <WebServer.h>
 
+#include "chess_engine.h"
+
 // ---------------------------
 // WiFi Configuration
 // ---------------------------
@@ -38,13 +40,13 @@ private:
     String gameMode;
     String startupType;
     
-    // Board state storage
-    char boardState[8][8];
+    // Board state storage, packed (side to move included)
+    PackedPosition boardState;
     bool boardStateValid;
     float boardEvaluation;  // Stockfish evaluation (in centipawns)
     
     // Board edit storage (pending edits from web interface)
-    char pendingBoardEdit[8][8];
+    PackedPosition pendingBoardEdit;
     bool hasPendingEdit;
     
     // WiFi connection methods
@@ -59,6 +61,7 @@ private:
     String generateBoardViewPage();
     String generateBoardEditPage();
     String generateBoardJSON();
+    String generateBoardPacked();
     String getPieceSymbol(char piece);
     void handleRoot();
     void handleGameSelection();
@@ -90,7 +93,7 @@ public:
     
     // Board state management
     void updateBoardState(char newBoardState[8][8]);
-    void updateBoardState(char newBoardState[8][8], float evaluation);
+    void updateBoardState(char newBoardState[8][8], float evaluation, bool whiteToMove = true);
     bool hasValidBoardState() { return boardStateValid; }
     float getEvaluation() { return boardEvaluation; }
     